@@ -34,6 +34,7 @@ CompareDialog::CompareDialog(QWidget * parent, Firmware * firmware):
 {
   ui->setupUi(this);
   setWindowIcon(CompanionIcon("compare.png"));
+  multimodelprinter->setSkipIdenticalSections(true);
   setAcceptDrops(true);
   if (!g.compareWinGeo().isEmpty()) {
     restoreGeometry(g.compareWinGeo());
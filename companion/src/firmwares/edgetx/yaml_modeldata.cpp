@@ -95,6 +95,13 @@ static const YamlLookupTable hatsModeLut = {
   {  GeneralSettings::HATSMODE_GLOBAL, "GLOBAL"  },
 };
 
+static const YamlLookupTable telemetryLinkModeLut = {
+  {  TELEMETRY_LINKS_SHARED, "LINKS_SHARED"  },
+  {  TELEMETRY_LINKS_SEPARATE, "LINKS_SEPARATE"  },
+  {  TELEMETRY_LINKS_BEST_RSSI, "LINKS_BEST_RSSI"  },
+  {  TELEMETRY_LINKS_FAILOVER, "LINKS_FAILOVER"  },
+};
+
 struct YamlTrim {
   int mode = 0;
   int ref = 0;
@@ -919,6 +926,7 @@ Node convert<ModelData>::encode(const ModelData& rhs)
   node["displayTrims"] = rhs.trimsDisplay;
   node["ignoreSensorIds"] = (int)rhs.frsky.ignoreSensorIds;
   node["showInstanceIds"] = (int)rhs.showInstanceIds;
+  node["telemetryLinkMode"] = telemetryLinkModeLut << rhs.telemetryLinkMode;
   node["disableThrottleWarning"] = (int)rhs.disableThrottleWarning;
   node["enableCustomThrottleWarning"] = (int)rhs.enableCustomThrottleWarning;
   node["customThrottleWarningPosition"] = (int)rhs.customThrottleWarningPosition;
@@ -1201,6 +1209,7 @@ bool convert<ModelData>::decode(const Node& node, ModelData& rhs)
   node["displayTrims"] >> rhs.trimsDisplay;
   node["ignoreSensorIds"] >> rhs.frsky.ignoreSensorIds;
   node["showInstanceIds"] >> rhs.showInstanceIds;
+  node["telemetryLinkMode"] >> telemetryLinkModeLut >> rhs.telemetryLinkMode;
   node["disableThrottleWarning"] >> rhs.disableThrottleWarning;
   node["enableCustomThrottleWarning"] >> rhs.enableCustomThrottleWarning;
   node["customThrottleWarningPosition"] >> rhs.customThrottleWarningPosition;
@@ -21,7 +21,8 @@
 #include "yaml_ops.h"
 
 SemanticVersion radioSettingsVersion;
-SemanticVersion modelSettingsVersion;
+// models are parsed concurrently, see YamlModelLoader
+thread_local SemanticVersion modelSettingsVersion;
 
 YAML::Node operator >> (const YAML::Node& node, const YamlLookupTable& lut)
 {
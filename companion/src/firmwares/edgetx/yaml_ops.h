@@ -174,4 +174,4 @@ struct convert_enum
   }
 
 extern SemanticVersion radioSettingsVersion;
-extern SemanticVersion modelSettingsVersion;
+extern thread_local SemanticVersion modelSettingsVersion;
@@ -95,6 +95,7 @@ Node convert<SensorData>::encode(const SensorData& rhs)
   }
 
   node["label"] = rhs.label;
+  node["module"] = rhs.module;
   node["unit"] = rhs.unit;
   node["prec"] = rhs.prec;
   node["autoOffset"] = (int)rhs.autoOffset;
@@ -130,6 +131,7 @@ bool convert<SensorData>::decode(const Node& node, SensorData& rhs)
   }
 
   node["label"] >> rhs.label;
+  node["module"] >> rhs.module;
   node["unit"] >> rhs.unit;
   node["prec"] >> rhs.prec;
   node["autoOffset"] >> rhs.autoOffset;
@@ -87,6 +87,13 @@ enum TrainerMode {
   TRAINER_MODE_LAST = TRAINER_MODE_MULTI
 };
 
+enum TelemetryLinkMode {
+  TELEMETRY_LINKS_SHARED,
+  TELEMETRY_LINKS_SEPARATE,
+  TELEMETRY_LINKS_BEST_RSSI,
+  TELEMETRY_LINKS_FAILOVER,
+};
+
 #define INPUT_NAME_LEN 4
 #define CPN_MAX_BITMAP_LEN 14
 
@@ -174,6 +181,7 @@ class ModelData {
     unsigned int  rssiSource;
     RSSIAlarmData rssiAlarms;
     bool showInstanceIds;
+    unsigned int telemetryLinkMode;  // TelemetryLinkMode
 
     char bitmap[CPN_MAX_BITMAP_LEN + 1];
 
@@ -150,6 +150,7 @@ class SensorData {
     unsigned int instance;
     unsigned int rxIdx;
     unsigned int moduleIdx;
+    unsigned int module;   // owning module when links use separate namespaces
     unsigned int persistentValue;
     unsigned int formula;
     char label[SENSOR_LABEL_LEN + 1];
@@ -0,0 +1,283 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "logdata.h"
+
+#include <cstring>
+
+static inline int parseDigits(const char * p, int count)
+{
+  int value = 0;
+  for (int i = 0; i < count; i++)
+    value = value * 10 + (p[i] - '0');
+  return value;
+}
+
+// strip trailing CR/LF and white space, as QString::trimmed() did
+static inline qint32 trimmedLength(const char * line, qint32 len)
+{
+  while (len > 0 && (unsigned char)line[len - 1] <= ' ')
+    len--;
+  return len;
+}
+
+static inline int countFields(const char * line, qint32 len)
+{
+  int count = 1;
+  const char * end = line + len;
+  while ((line = (const char *)memchr(line, ',', end - line))) {
+    count++;
+    line++;
+  }
+  return count;
+}
+
+LogData::LogData() :
+  data(nullptr),
+  size(0),
+  headerLength(0),
+  lastDateHourSecs(0)
+{
+}
+
+LogData::~LogData()
+{
+  clear();
+}
+
+void LogData::clear()
+{
+  if (data) {
+    file.unmap((uchar *)data);
+    data = nullptr;
+  }
+  if (file.isOpen())
+    file.close();
+
+  size = 0;
+  headerLength = 0;
+  fields.clear();
+  records.clear();
+  columns.clear();
+  parsed.clear();
+  times.clear();
+  lastDateHour.clear();
+}
+
+bool LogData::load(const QString & filename, int & errors, int & lines)
+{
+  clear();
+  errors = 0;
+  lines = -1;
+
+  file.setFileName(filename);
+  if (!file.open(QIODevice::ReadOnly))
+    return false;
+
+  size = file.size();
+  data = (const char *)file.map(0, size);
+  if (!data || size < 9 || strncmp(data, "Date,Time", 9)) {
+    clear();
+    return false;
+  }
+
+  int numfields = -1;
+  const char * end = data + size;
+  const char * line = data;
+
+  while (line < end) {
+    const char * eol = (const char *)memchr(line, '\n', end - line);
+    qint32 len = (eol ? eol : end) - line;
+    qint32 trimmed = trimmedLength(line, len);
+    int count = countFields(line, trimmed);
+
+    if (numfields == -1) {
+      numfields = count;
+      headerLength = trimmed;
+      fields = QString::fromUtf8(line, trimmed).split(',');
+    }
+    else if (count == numfields) {
+      records.push_back({line - data, trimmed});
+    }
+    else {
+      errors++;
+    }
+    lines++;
+
+    line += len + 1;
+  }
+
+  columns.resize(fields.count());
+  parsed.assign(fields.count(), false);
+
+  return !records.empty();
+}
+
+bool LogData::fieldBounds(int row, int col, const char *& begin, const char *& end) const
+{
+  if (row < 0 || row >= rowCount() || col < 0 || col >= columnCount())
+    return false;
+
+  const Record & rec = records[row];
+  const char * p = data + rec.offset;
+  const char * eol = p + rec.length;
+
+  for (int i = 0; i < col; i++) {
+    p = (const char *)memchr(p, ',', eol - p);
+    if (!p)
+      return false;
+    p++;
+  }
+
+  begin = p;
+  end = (const char *)memchr(p, ',', eol - p);
+  if (!end)
+    end = eol;
+  return true;
+}
+
+QString LogData::cell(int row, int col) const
+{
+  const char * begin;
+  const char * end;
+  if (!fieldBounds(row, col, begin, end))
+    return QString();
+  return QString::fromUtf8(begin, end - begin);
+}
+
+QStringList LogData::record(int row) const
+{
+  return QString::fromUtf8(rawRecord(row)).split(',');
+}
+
+QByteArray LogData::rawRecord(int row) const
+{
+  if (row < 0 || row >= rowCount())
+    return QByteArray();
+  return QByteArray(data + records[row].offset, records[row].length);
+}
+
+QByteArray LogData::rawHeader() const
+{
+  return QByteArray(data, headerLength);
+}
+
+const std::vector<double> & LogData::column(int col) const
+{
+  static const std::vector<double> empty;
+  if (col < 0 || col >= columnCount())
+    return empty;
+
+  if (!parsed[col]) {
+    std::vector<double> & values = columns[col];
+    values.resize(records.size());
+    for (int row = 0; row < rowCount(); row++) {
+      const char * begin;
+      const char * end;
+      fieldBounds(row, col, begin, end);
+      // QByteArray::toDouble() always uses the C locale, as QString::toDouble() did
+      values[row] = QByteArray::fromRawData(begin, end - begin).toDouble();
+    }
+    parsed[col] = true;
+  }
+
+  return columns[col];
+}
+
+double LogData::parseTime(const char * date, int dateLen, const char * time, int timeLen) const
+{
+  // "yyyy-MM-dd" and "HH:mm:ss" with optional ".zzz"
+  if (dateLen < 10 || timeLen < 8)
+    return 0;
+
+  if (lastDateHour.size() != 13 || memcmp(lastDateHour.constData(), date, 10) ||
+      memcmp(lastDateHour.constData() + 11, time, 2)) {
+    lastDateHour = QByteArray(date, 10) + ' ' + QByteArray(time, 2);
+    QDateTime dt(QDate(parseDigits(date, 4), parseDigits(date + 5, 2), parseDigits(date + 8, 2)),
+                 QTime(parseDigits(time, 2), 0));
+    lastDateHourSecs = dt.isValid() ? dt.toMSecsSinceEpoch() / 1000.0 : 0;
+  }
+
+  double secs = lastDateHourSecs + parseDigits(time + 3, 2) * 60 + parseDigits(time + 6, 2);
+  if (timeLen > 8 && time[8] == '.')
+    secs += QByteArray::fromRawData(time + 8, timeLen - 8).toDouble();
+  return secs;
+}
+
+const std::vector<double> & LogData::timestamps() const
+{
+  if (times.size() != records.size()) {
+    times.resize(records.size());
+    for (int row = 0; row < rowCount(); row++) {
+      const char * date;
+      const char * dateEnd;
+      const char * time;
+      const char * timeEnd;
+      fieldBounds(row, 0, date, dateEnd);
+      fieldBounds(row, 1, time, timeEnd);
+      times[row] = parseTime(date, dateEnd - date, time, timeEnd - time);
+    }
+  }
+  return times;
+}
+
+QDateTime LogData::timestamp(int row) const
+{
+  if (row < 0 || row >= rowCount())
+    return QDateTime();
+  return QDateTime::fromMSecsSinceEpoch(qRound64(timestamps()[row] * 1000));
+}
+
+LogTableModel::LogTableModel(const LogData & log, QObject * parent) :
+  QAbstractTableModel(parent),
+  log(log)
+{
+}
+
+void LogTableModel::reload()
+{
+  beginResetModel();
+  endResetModel();
+}
+
+int LogTableModel::rowCount(const QModelIndex & parent) const
+{
+  return parent.isValid() ? 0 : log.rowCount();
+}
+
+int LogTableModel::columnCount(const QModelIndex & parent) const
+{
+  return parent.isValid() ? 0 : log.columnCount();
+}
+
+QVariant LogTableModel::data(const QModelIndex & index, int role) const
+{
+  if (!index.isValid() || role != Qt::DisplayRole)
+    return QVariant();
+  return log.cell(index.row(), index.column());
+}
+
+QVariant LogTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+  if (orientation == Qt::Horizontal && role == Qt::DisplayRole && section < log.columnCount())
+    return log.header().at(section);
+  return QAbstractTableModel::headerData(section, orientation, role);
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <QAbstractTableModel>
+#include <QDateTime>
+#include <QFile>
+#include <QStringList>
+
+#include <vector>
+
+/*
+  Column oriented view of a radio CSV log.
+
+  The file is memory mapped and only the start of every valid record is
+  indexed on load. Cells are read straight from the mapping on demand and
+  numeric columns are converted to double the first time they are asked for,
+  so columns that are never plotted are never parsed.
+*/
+class LogData
+{
+  public:
+    LogData();
+    ~LogData();
+
+    bool load(const QString & filename, int & errors, int & lines);
+    void clear();
+
+    int rowCount() const { return (int)records.size(); }
+    int columnCount() const { return fields.count(); }
+    const QStringList & header() const { return fields; }
+
+    QString cell(int row, int col) const;
+    QStringList record(int row) const;
+    QByteArray rawRecord(int row) const;
+    QByteArray rawHeader() const;
+
+    const std::vector<double> & column(int col) const;
+    // seconds since epoch, including milliseconds
+    const std::vector<double> & timestamps() const;
+    QDateTime timestamp(int row) const;
+
+  private:
+    struct Record {
+      qint64 offset;
+      qint32 length;
+    };
+
+    bool fieldBounds(int row, int col, const char *& begin, const char *& end) const;
+    double parseTime(const char * date, int dateLen, const char * time, int timeLen) const;
+
+    QFile file;
+    const char * data;
+    qint64 size;
+    qint32 headerLength;
+    QStringList fields;
+    std::vector<Record> records;
+
+    mutable std::vector<std::vector<double>> columns;
+    mutable std::vector<bool> parsed;
+    mutable std::vector<double> times;
+
+    // local time of the last parsed date/hour, avoids a timezone lookup per record
+    mutable QByteArray lastDateHour;
+    mutable double lastDateHourSecs;
+};
+
+class LogTableModel : public QAbstractTableModel
+{
+  Q_OBJECT
+
+  public:
+    explicit LogTableModel(const LogData & log, QObject * parent = nullptr);
+
+    void reload();
+
+    int rowCount(const QModelIndex & parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex & parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex & index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+  private:
+    const LogData & log;
+};
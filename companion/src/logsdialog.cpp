@@ -19,6 +19,7 @@
  */
 
 #include <math.h>
+#include <numeric>
 #include "logsdialog.h"
 #include "appdata.h"
 #include "ui_logsdialog.h"
@@ -37,9 +38,11 @@ LogsDialog::LogsDialog(QWidget *parent) :
   cursorB(0),
   cursorLine(0)
 {
-  csvlog.clear();
-
   ui->setupUi(this);
+
+  logModel = new LogTableModel(logData, this);
+  ui->logTable->setModel(logModel);
+  ui->logTable->setSelectionBehavior(QAbstractItemView::SelectRows);
   setWindowIcon(CompanionIcon("logs.png"));
 
   plotLock=false;
@@ -117,12 +120,14 @@ LogsDialog::LogsDialog(QWidget *parent) :
 
   // make left axes transfer its range to right axes:
   connect(axisRect->axis(QCPAxis::atLeft), static_cast<void(QCPAxis::*)(const QCPRange&)>(&QCPAxis::rangeChanged), this, &LogsDialog::yAxisChangeRanges);
+  // re-decimate the graphs data when zooming or panning in time
+  connect(axisRect->axis(QCPAxis::atBottom), static_cast<void(QCPAxis::*)(const QCPRange&)>(&QCPAxis::rangeChanged), this, &LogsDialog::xAxisChangeRanges);
   // connect some interaction slots:
   connect(title, &QCPTextElement::doubleClicked, this, &LogsDialog::titleDoubleClicked);
   connect(ui->customPlot, &QCustomPlot::axisDoubleClick, this, &LogsDialog::axisLabelDoubleClick);
   connect(ui->customPlot, &QCustomPlot::legendDoubleClick, this, &LogsDialog::legendDoubleClick);
   connect(ui->FieldsTW, &QTableWidget::itemSelectionChanged, this, &LogsDialog::plotLogs);
-  connect(ui->logTable, &QTableWidget::itemSelectionChanged, this, &LogsDialog::plotLogs);
+  connect(ui->logTable->selectionModel(), &QItemSelectionModel::selectionChanged, this, &LogsDialog::plotLogs);
   connect(ui->Reset_PB, &QPushButton::clicked, this, &LogsDialog::plotLogs);
   connect(ui->SaveSession_PB, &QPushButton::clicked, this, &LogsDialog::saveSession);
   connect(ui->fileOpen_PB, &QPushButton::clicked, this, &LogsDialog::fileOpen);
@@ -248,18 +253,18 @@ void LogsDialog::selectionChanged()
   }
 }
 
-QList<QStringList> LogsDialog::filterGePoints(const QList<QStringList> & input)
+QList<QStringList> LogsDialog::filterGePoints()
 {
   QList<QStringList> result;
 
-  int n = input.count();
+  int n = logData.rowCount();
   if (n == 0) {
     return result;
   }
 
   int gpscol = 0;
-  for (int i=1; i<input.at(0).count(); i++) {
-    if (input.at(0).at(i) == "GPS") {
+  for (int i=1; i<logData.columnCount(); i++) {
+    if (logData.header().at(i) == "GPS") {
       gpscol=i;
     }
   }
@@ -270,16 +275,17 @@ The columns for altitude \"GAlt\" and for speed \"GSpd\" are optional"));
     return result;
   }
 
-  result.append(input.at(0));
-  bool rangeSelected = ui->logTable->selectionModel()->selectedRows().length() > 0;
+  result.append(logData.header());
+  QItemSelectionModel * selection = ui->logTable->selectionModel();
+  bool rangeSelected = selection->hasSelection();
 
   GpsGlitchFilter glitchFilter;
   GpsLatLonFilter latLonFilter;
 
-  for (int i = 1; i < n; i++) {
-    if ((ui->logTable->item(i-1, 1)->isSelected() && rangeSelected) || !rangeSelected) {
+  for (int i = 0; i < n; i++) {
+    if ((selection->isRowSelected(i, QModelIndex()) && rangeSelected) || !rangeSelected) {
 
-      GpsCoord coord = extractGpsCoordinates(input.at(i).at(gpscol));
+      GpsCoord coord = extractGpsCoordinates(logData.cell(i, gpscol));
 
       // glitch filter
       if ( glitchFilter.isGlitch(coord) ) {
@@ -294,18 +300,18 @@ The columns for altitude \"GAlt\" and for speed \"GSpd\" are optional"));
       }
 
       // qDebug() << "point " << latitude << longitude;
-      result.append(input.at(i));
+      result.append(logData.record(i));
     }
   }
 
-  // qDebug() << "filterGePoints(): filtered from" << input.count() << "to " << result.count() << "points";
+  // qDebug() << "filterGePoints(): filtered from" << n << "to " << result.count() << "points";
   return result;
 }
 
 void LogsDialog::exportToGoogleEarth()
 {
   // filter data points
-  QList<QStringList> dataPoints = filterGePoints(csvlog);
+  QList<QStringList> dataPoints = filterGePoints();
   int n = dataPoints.count(); // number of points to export
   if (n==0) return;
 
@@ -555,6 +561,7 @@ void LogsDialog::mouseWheel()
 
 void LogsDialog::removeAllGraphs()
 {
+  plottedCoords.clear();
   ui->customPlot->clearGraphs();
   ui->customPlot->clearItems();
   ui->customPlot->legend->setVisible(false);
@@ -585,38 +592,19 @@ void LogsDialog::fileOpen()
     ui->FileName_LE->setText(fileName);
     if (cvsFileParse()) {
       ui->FieldsTW->clear();
-      ui->logTable->clear();
       ui->FieldsTW->setShowGrid(false);
       ui->FieldsTW->setContentsMargins(0,0,0,0);
-      ui->FieldsTW->setRowCount(csvlog.at(0).count()-2);
+      ui->FieldsTW->setRowCount(logData.columnCount()-2);
       ui->FieldsTW->setColumnCount(1);
       ui->FieldsTW->setHorizontalHeaderLabels(QStringList(tr("Available fields")));
-      ui->logTable->setSelectionBehavior(QAbstractItemView::SelectRows);
-      for (int i=2; i<csvlog.at(0).count(); i++) {
-        QTableWidgetItem* item= new QTableWidgetItem(csvlog.at(0).at(i));
+      for (int i=2; i<logData.columnCount(); i++) {
+        QTableWidgetItem* item= new QTableWidgetItem(logData.header().at(i));
         ui->FieldsTW->setItem(i-2, 0, item);
       }
       ui->FieldsTW->resizeRowsToContents();
-      ui->logTable->setColumnCount(csvlog.at(0).count());
-      ui->logTable->setRowCount(csvlog.count()-1);
-      ui->logTable->setHorizontalHeaderLabels(csvlog.at(0));
-
-      QAbstractItemModel *model = ui->logTable->model();
-      for (int i=1; i<csvlog.count(); i++) {
-        for (int j=0; j<csvlog.at(0).count(); j++) {
-          model->setData(model->index(i - 1, j, QModelIndex()), csvlog.at(i).at(j));
-        }
-      }
 
-      ui->logTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
-      QVarLengthArray<int> sizes;
-      for (int i = 0; i < ui->logTable->columnCount(); i++) {
-        sizes.append(ui->logTable->columnWidth(i));
-      }
-      ui->logTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
-      for (int i = 0; i < ui->logTable->columnCount(); i++) {
-        ui->logTable->setColumnWidth(i, sizes.at(i));
-      }
+      // only a sample of the rows is measured, see QHeaderView::resizeContentsPrecision()
+      ui->logTable->resizeColumnsToContents();
     }
   }
 }
@@ -626,95 +614,51 @@ void LogsDialog::saveSession()
   int index = ui->sessions_CB->currentIndex();
   // ignore index 0 is its all sessions combined
   if(index > 0) {
-    int n = csvlog.count();
-    QList<QStringList> sessionCsvLog;
-    // add CSV headers from first row of source file
-    sessionCsvLog.push_back(csvlog[0]);
-    // find session breaks
-    int currentSession = 0;
-    QDateTime lastvalue;
-    for (int i = 1; i < n; i++) {
-      QDateTime tmp = getRecordTimeStamp(i);
-      if (!lastvalue.isValid() || lastvalue.secsTo(tmp) > 60) {
-        currentSession++;
-      }
-      lastvalue = tmp;
-      if(currentSession == index) {
-        // add records to filtered list
-        sessionCsvLog.push_back(csvlog[i]);
-      }
-      else if (currentSession > index) {
-        break;
-      }
+    int n = logData.rowCount();
+    int first = ui->sessions_CB->itemData(index, Qt::UserRole).toInt();
+    int last = n;
+    if (index < ui->sessions_CB->count() - 1) {
+      last = ui->sessions_CB->itemData(index + 1, Qt::UserRole).toInt();
     }
-    // save the filtered records to a new file
+    // save the session records to a new file
     QString newFilename = logFilename;
     newFilename.append(QString("-Session%1.csv").arg(index));
     QString filename = QFileDialog::getSaveFileName(this, "Save log", newFilename, "CSV files (.csv);", 0, 0); // getting the filename (full path)
     QFile data(filename);
     if(data.open(QFile::WriteOnly |QFile::Truncate)) {
-      QTextStream output(&data);
-      int numRecords = sessionCsvLog.count();
-      for(int i = 0; i < numRecords; i++){
-        output << sessionCsvLog[i].join(",") << '\n';
+      // add CSV headers from first row of source file
+      data.write(logData.rawHeader() + '\n');
+      for(int i = first; i < last; i++){
+        data.write(logData.rawRecord(i) + '\n');
       }
     }
-    sessionCsvLog.clear();
   }
 }
 
 bool LogsDialog::cvsFileParse()
 {
-  QFile file(ui->FileName_LE->text());
   int errors=0;
   int lines=-1;
 
-  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) { // reading HEX TEXT file
+  removeAllGraphs();
+  plottedCoords.clear();
+  ui->logTable->selectionModel()->clearSelection();
+  logFilename.clear();
+
+  bool ok = logData.load(ui->FileName_LE->text(), errors, lines);
+  logModel->reload();
+  if (!ok) {
+    logData.clear();
+    logModel->reload();
     return false;
   }
-  else {
-    csvlog.clear();
-    logFilename.clear();
-    QTextStream inputStream(&file);
-    QString buffer = file.readLine();
-
-    if (buffer.startsWith("Date,Time")) {
-      file.reset();
-    }
-    else {
-      return false;
-    }
 
-    int numfields=-1;
-    while (!file.atEnd()) {
-      QString line = file.readLine().trimmed();
-      QStringList columns = line.split(',');
-      if (numfields==-1) {
-        numfields=columns.count();
-      }
-      if (columns.count()==numfields) {
-        csvlog.append(columns);
-      }
-      else {
-        errors++;
-      }
-      lines++;
-    }
-
-    logFilename = QFileInfo(file.fileName()).baseName();
-  }
+  logFilename = QFileInfo(ui->FileName_LE->text()).baseName();
 
-  file.close();
   if (errors > 1) {
     QMessageBox::warning(this, CPN_STR_APP_NAME, tr("The selected logfile contains %1 invalid lines out of  %2 total lines").arg(errors).arg(lines));
   }
 
-  int n = csvlog.count();
-  if (n == 1) {
-    csvlog.clear();
-    return false;
-  }
-
   plotLock = true;
   setFlightSessions();
   plotLock = false;
@@ -729,10 +673,7 @@ struct FlightSession {
 
 QDateTime LogsDialog::getRecordTimeStamp(int index)
 {
-  QString tstamp = csvlog.at(index).at(0) + " " + csvlog.at(index).at(1);
-  if (csvlog.at(index).at(1).contains("."))
-    return QDateTime::fromString(tstamp, "yyyy-MM-dd HH:mm:ss.zzz");
-  return QDateTime::fromString(tstamp, "yyyy-MM-dd HH:mm:ss");
+  return logData.timestamp(index);
 }
 
 QString LogsDialog::generateDuration(const QDateTime & start, const QDateTime & end)
@@ -752,35 +693,33 @@ void LogsDialog::setFlightSessions()
   ui->sessions_CB->clear();
   ui->SaveSession_PB->setEnabled(false);
 
-  int n = csvlog.count();
+  int n = logData.rowCount();
+  const std::vector<double> & times = logData.timestamps();
   // qDebug() << "records" << n;
 
-  // find session breaks
+  // find session breaks, each entry is the first row of a session
   QList<int> sessions;
-  QDateTime lastvalue;
-  for (int i = 1; i < n; i++) {
-    QDateTime tmp = getRecordTimeStamp(i);
-    if (!lastvalue.isValid() || lastvalue.secsTo(tmp) > 60) {
-      sessions.push_back(i-1);
-      // qDebug() << "session index" << i-1;
+  for (int i = 0; i < n; i++) {
+    if (i == 0 || times[i] - times[i-1] > 60) {
+      sessions.push_back(i);
+      // qDebug() << "session index" << i;
     }
-    lastvalue = tmp;
   }
-  sessions.push_back(n-1);
+  sessions.push_back(n);
 
   //now construct a list of sessions with their times
   //total time
   int noSesions = sessions.size()-1;
   QString label = QString("%1 ").arg(noSesions);
   label += tr(noSesions > 1 ? "sessions" : "session");
-  label += " <" + tr("time span") + generateDuration(getRecordTimeStamp(1), getRecordTimeStamp(n-1)) + ">";
+  label += " <" + tr("time span") + generateDuration(getRecordTimeStamp(0), getRecordTimeStamp(n-1)) + ">";
   ui->sessions_CB->addItem(label);
 
   // add individual sessions
   if (sessions.size() > 2) {
     for (int i = 1; i < sessions.size(); i++) {
-      QDateTime sessionStart = getRecordTimeStamp(sessions.at(i-1)+1);
-      QDateTime sessionEnd = getRecordTimeStamp(sessions.at(i));
+      QDateTime sessionStart = getRecordTimeStamp(sessions.at(i-1));
+      QDateTime sessionEnd = getRecordTimeStamp(sessions.at(i)-1);
       QString label = sessionStart.toString("HH:mm:ss") + " <" + tr("duration ") + generateDuration(sessionStart, sessionEnd) + ">";
       ui->sessions_CB->addItem(label, sessions.at(i-1));
       // qDebug() << "added label" << label << sessions.at(i-1);
@@ -800,13 +739,13 @@ void LogsDialog::sessionsCurrentIndexChanged(int index)
     if (index < ui->sessions_CB->count() - 1) {
       bottom = ui->sessions_CB->itemData(index + 1, Qt::UserRole).toInt();
     } else {
-      bottom = ui->logTable->rowCount();
+      bottom = logModel->rowCount();
     }
 
     QModelIndex topLeft = ui->logTable->model()->index(
       ui->sessions_CB->itemData(index, Qt::UserRole).toInt(), 0 , QModelIndex());
     QModelIndex bottomRight = ui->logTable->model()->index(
-      bottom - 1, ui->logTable->columnCount() - 1, QModelIndex());
+      bottom - 1, logModel->columnCount() - 1, QModelIndex());
 
     QItemSelection selection(topLeft, bottomRight);
     ui->logTable->selectionModel()->select(selection, QItemSelectionModel::Select);
@@ -845,9 +784,11 @@ void LogsDialog::plotLogs()
     std::sort(selectedRows.begin(), selectedRows.end());
   } else {
     hasLogSelection = false;
-    rowCount = ui->logTable->rowCount();
+    rowCount = logData.rowCount();
   }
 
+  const std::vector<double> & times = logData.timestamps();
+
   plots.min_x = QDateTime::currentDateTime().toTime_t();
   plots.max_x = 0;
 
@@ -860,42 +801,42 @@ void LogsDialog::plotLogs()
     plotCoords.yaxis = firstLeft;
     plotCoords.name = plot->text();
 
+    const std::vector<double> & values = logData.column(plotColumn);
+    plotCoords.x.reserve(rowCount);
+    plotCoords.y.reserve(rowCount);
+
     for (int row = 0; row < rowCount; row++) {
-      QTableWidgetItem *logValue;
-      double y;
-      double time;
-      QString time_str;
-
-      if (hasLogSelection) {
-        logValue = ui->logTable->item(selectedRows.at(row), plotColumn);
-        time_str = ui->logTable->item(selectedRows.at(row), 0)->text() +
-          QString(" ") + ui->logTable->item(selectedRows.at(row), 1)->text();
-      } else {
-        logValue = ui->logTable->item(row, plotColumn);
-        time_str = ui->logTable->item(row, 0)->text() + QString(" ") +
-          ui->logTable->item(row, 1)->text();
-      }
+      int index = hasLogSelection ? selectedRows.at(row) : row;
+      double y = values[index];
+      double time = times[index];
 
-      y = logValue->text().toDouble();
       plotCoords.y.push_back(y);
 
       if (plotCoords.min_y > y) plotCoords.min_y = y;
       if (plotCoords.max_y < y) plotCoords.max_y = y;
 
-      if (time_str.contains('.')) {
-        time = QDateTime::fromString(time_str, "yyyy-MM-dd HH:mm:ss.zzz")
-          .toTime_t();
-        time += time_str.mid(time_str.indexOf('.')).toDouble();
-      } else {
-        time = QDateTime::fromString(time_str, "yyyy-MM-dd HH:mm:ss")
-          .toTime_t();
-      }
       plotCoords.x.push_back(time);
 
       if (plots.min_x > time) plots.min_x = time;
       if (plots.max_x < time) plots.max_x = time;
     }
 
+    // the radio clock may step back between sessions, graphs need time ordered data
+    if (!std::is_sorted(plotCoords.x.constBegin(), plotCoords.x.constEnd())) {
+      QVector<int> order(plotCoords.x.size());
+      std::iota(order.begin(), order.end(), 0);
+      std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return plotCoords.x.at(a) < plotCoords.x.at(b); });
+      QVector<double> x, y;
+      x.reserve(order.size());
+      y.reserve(order.size());
+      for (int idx : order) {
+        x.append(plotCoords.x.at(idx));
+        y.append(plotCoords.y.at(idx));
+      }
+      plotCoords.x = x;
+      plotCoords.y = y;
+    }
+
     double range_inc = (plotCoords.max_y - plotCoords.min_y) / 100;
     if (range_inc == 0) range_inc = 1;
     plotCoords.max_y += range_inc;
@@ -1058,7 +999,8 @@ void LogsDialog::plotLogs()
     }
 
     ui->customPlot->graph(i)->setData(plots.coords.at(i).x,
-      plots.coords.at(i).y);
+      plots.coords.at(i).y, true);
+    plottedCoords.append(plots.coords.at(i));
     pen.setColor(colors.at(i % colors.size()));
     ui->customPlot->graph(i)->setPen(pen);
 
@@ -1075,9 +1017,65 @@ void LogsDialog::plotLogs()
   }
 
   ui->customPlot->legend->setVisible(true);
+  updateGraphsData();
   ui->customPlot->replot();
 }
 
+// Keeps at most two points (min and max) per horizontal pixel of the visible
+// time range, so that long logs stay responsive when zoomed out. All points
+// are kept once zoomed in enough for them to be told apart.
+void LogsDialog::updateGraphsData()
+{
+  const QCPRange range = axisRect->axis(QCPAxis::atBottom)->range();
+  const int buckets = qMax(axisRect->width(), 100);
+
+  for (int i = 0; i < plottedCoords.size() && i < ui->customPlot->graphCount(); i++) {
+    const coords_t & c = plottedCoords.at(i);
+    const int n = c.x.size();
+
+    // visible slice, plus one point each side so lines reach the plot edges
+    int first = std::lower_bound(c.x.constBegin(), c.x.constEnd(), range.lower) - c.x.constBegin();
+    int last = std::upper_bound(c.x.constBegin(), c.x.constEnd(), range.upper) - c.x.constBegin();
+    first = qMax(first - 1, 0);
+    last = qMin(last + 1, n);
+
+    QVector<QCPGraphData> points;
+    if (last - first <= buckets * 4) {
+      points.reserve(last - first);
+      for (int j = first; j < last; j++)
+        points.append(QCPGraphData(c.x.at(j), c.y.at(j)));
+    }
+    else {
+      points.reserve(buckets * 2 + 2);
+      const double width = (range.upper - range.lower) / buckets;
+      int j = first;
+      while (j < last) {
+        const double bucketEnd = c.x.at(j) + width;
+        int minIdx = j, maxIdx = j;
+        // the first sample is always consumed, even if width is below
+        // the resolution of the timestamps
+        for (j++; j < last && c.x.at(j) < bucketEnd; j++) {
+          if (c.y.at(j) < c.y.at(minIdx)) minIdx = j;
+          if (c.y.at(j) > c.y.at(maxIdx)) maxIdx = j;
+        }
+        // keep both extremes, in time order
+        int a = qMin(minIdx, maxIdx), b = qMax(minIdx, maxIdx);
+        points.append(QCPGraphData(c.x.at(a), c.y.at(a)));
+        if (b != a)
+          points.append(QCPGraphData(c.x.at(b), c.y.at(b)));
+      }
+    }
+    ui->customPlot->graph(i)->data()->set(points, true);
+  }
+}
+
+void LogsDialog::xAxisChangeRanges(QCPRange range)
+{
+  Q_UNUSED(range);
+  if (!plotLock)
+    updateGraphsData();
+}
+
 void LogsDialog::yAxisChangeRanges(QCPRange range)
 {
   if (axisRect->axis(QCPAxis::atRight)->visible()) {
@@ -37,6 +37,7 @@
 
 #include <algorithm>
 #include <ExportableTableView>
+#include <QProgressDialog>
 
 MdiChild::MdiChild(QWidget * parent, QWidget * parentWin, Qt::WindowFlags f):
   QWidget(parent, f),
@@ -1262,11 +1263,23 @@ bool MdiChild::loadFile(const QString & filename, bool resetCurrentFile)
     resetCurrentFile = false;
   }
 
+  QProgressDialog progress(tr("Loading models..."), tr("Cancel"), 0, 0, this);
+  progress.setWindowModality(Qt::WindowModal);
+  progress.setMinimumDuration(500);
+
   Storage storage(filename);
+  storage.setProgressCallback([&progress](int done, int total) {
+    progress.setMaximum(total);
+    progress.setValue(done);
+    QCoreApplication::processEvents();
+    return !progress.wasCanceled();
+  });
   if (!storage.load(radioData)) {
+    progress.reset();
     QMessageBox::critical(this, CPN_STR_TTL_ERROR, storage.error());
     return false;
   }
+  progress.reset();
 
   QString warning = storage.warning();
   if (!warning.isEmpty()) {
@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "modeldiff.h"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+
+class Hash
+{
+  public:
+    explicit Hash(quint64 seed = 0) : value(seed ^ 0xcbf29ce484222325ull) {}
+
+    void add(const void * data, size_t len)
+    {
+      const char * p = (const char *)data;
+      while (len >= 8) {
+        quint64 word;
+        memcpy(&word, p, 8);
+        mix(word);
+        p += 8;
+        len -= 8;
+      }
+      if (len) {
+        quint64 word = 0;
+        memcpy(&word, p, len);
+        mix(word ^ ((quint64)len << 56));
+      }
+    }
+
+    void add(quint64 word)
+    {
+      mix(word);
+    }
+
+    quint64 result() const
+    {
+      quint64 h = value;
+      h ^= h >> 33;
+      h *= 0xff51afd7ed558ccdull;
+      h ^= h >> 33;
+      return h;
+    }
+
+  private:
+    void mix(quint64 word)
+    {
+      word *= 0x87c37b91114253d5ull;
+      word = (word << 31) | (word >> 33);
+      value ^= word;
+      value = ((value << 27) | (value >> 37)) * 5 + 0x52dce729;
+    }
+
+    quint64 value;
+};
+
+struct Range {
+  size_t offset;
+  size_t length;
+};
+
+template <class T>
+Range range(const ModelData & model, const T & member)
+{
+  return { (size_t)((const char *)&member - (const char *)&model), sizeof(T) };
+}
+
+template <class T>
+quint64 hashOf(const T & data)
+{
+  Hash hash;
+  hash.add(&data, sizeof(T));
+  return hash.result();
+}
+
+// everything in the model that is not owned by a single section
+quint64 contextHash(const ModelData & model, const GeneralSettings & settings)
+{
+  std::vector<Range> excluded = {
+    // Companion bookkeeping, not part of the model
+    range(model, model.used),
+    range(model, model.filename),
+    range(model, model.modelIndex),
+    range(model, model.modelUpdated),
+    // owned by a section
+    range(model, model.semver),
+    range(model, model.name),
+    range(model, model.labels),
+    range(model, model.bitmap),
+    range(model, model.timers),
+    range(model, model.moduleData),
+    range(model, model.expoData),
+    range(model, model.mixData),
+    range(model, model.curves),
+    range(model, model.logicalSw),
+    range(model, model.customFn),
+  };
+  std::sort(excluded.begin(), excluded.end(),
+            [](const Range & a, const Range & b) { return a.offset < b.offset; });
+
+  // the reference update state at the end of the class is transient
+  const Range last = range(model, model.usbJoystickCh);
+  const size_t end = last.offset + last.length;
+
+  const char * data = (const char *)&model;
+  Hash hash;
+  size_t pos = 0;
+  for (const Range & r : excluded) {
+    if (r.offset > pos)
+      hash.add(data + pos, r.offset - pos);
+    pos = std::max(pos, r.offset + r.length);
+  }
+  if (end > pos)
+    hash.add(data + pos, end - pos);
+
+  // timer and curve names show up in sources and references of other sections
+  for (const TimerData & timer : model.timers)
+    hash.add(timer.name, sizeof(timer.name));
+  for (const CurveData & curve : model.curves)
+    hash.add(curve.name, sizeof(curve.name));
+
+  hash.add(hashOf(settings));
+  return hash.result();
+}
+
+template <class Job>
+void parallelFor(int count, Job job)
+{
+  int threads = std::min<int>(count, std::max(1u, std::thread::hardware_concurrency()));
+  if (threads <= 1) {
+    for (int i = 0; i < count; i++)
+      job(i);
+    return;
+  }
+
+  std::vector<std::thread> workers;
+  int chunk = (count + threads - 1) / threads;
+  for (int first = 0; first < count; first += chunk) {
+    int last = std::min(first + chunk, count);
+    workers.emplace_back([&job, first, last]() {
+      for (int i = first; i < last; i++)
+        job(i);
+    });
+  }
+  for (std::thread & worker : workers)
+    worker.join();
+}
+
+}
+
+ModelDiff::Digest ModelDiff::digest(const ModelData & model, const GeneralSettings & settings)
+{
+  const quint64 context = contextHash(model, settings);
+
+  Digest result;
+  for (int i = 0; i < SECTION_COUNT; i++)
+    result.section[i] = context;
+
+  auto own = [&](Section section, std::initializer_list<quint64> parts) {
+    Hash hash(context);
+    for (quint64 part : parts)
+      hash.add(part);
+    result.section[section] = hash.result();
+  };
+
+  own(SECTION_SETUP, { hashOf(model.semver), hashOf(model.name), hashOf(model.labels), hashOf(model.bitmap) });
+  own(SECTION_TIMERS, { hashOf(model.timers) });
+  own(SECTION_MODULES, { hashOf(model.moduleData) });
+  own(SECTION_INPUTS, { hashOf(model.expoData) });
+  own(SECTION_MIXERS, { hashOf(model.mixData) });
+  own(SECTION_CURVES, { hashOf(model.curves) });
+  own(SECTION_LOGICAL_SWITCHES, { hashOf(model.logicalSw) });
+  own(SECTION_SPECIAL_FUNCTIONS, { hashOf(model.customFn) });
+
+  // the checklist is read from a file on the SD card structure, never assume it is the same
+  result.section[SECTION_CHECKLIST] = 0;
+
+  return result;
+}
+
+QVector<ModelDiff::Digest> ModelDiff::digests(const QVector<Entry> & entries)
+{
+  QVector<Digest> result(entries.size());
+  Digest * out = result.data();
+  parallelFor(entries.size(), [&](int i) {
+    out[i] = digest(*entries.at(i).first, *entries.at(i).second);
+  });
+  return result;
+}
+
+quint32 ModelDiff::differingSections(const QVector<Digest> & digests)
+{
+  quint32 mask = (1u << SECTION_CHECKLIST);
+  for (int i = 1; i < digests.size(); i++) {
+    for (int s = 0; s < SECTION_COUNT; s++) {
+      if (digests[i].section[s] != digests[0].section[s])
+        mask |= (1u << s);
+    }
+  }
+  return mask;
+}
+
+QVector<quint32> ModelDiff::compare(const QVector<QPair<Entry, Entry>> & pairs)
+{
+  QVector<quint32> result(pairs.size());
+  quint32 * out = result.data();
+  parallelFor(pairs.size(), [&](int i) {
+    const QPair<Entry, Entry> & pair = pairs.at(i);
+    out[i] = differingSections({ digest(*pair.first.first, *pair.first.second),
+                                    digest(*pair.second.first, *pair.second.second) });
+  });
+  return result;
+}
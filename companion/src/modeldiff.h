@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#pragma once
+
+#include "eeprominterface.h"
+
+#include <QPair>
+#include <QVector>
+
+/*
+  Structural comparison of models.
+
+  Every printed section of a model gets a 64 bit digest over the raw data it
+  is rendered from, so models can be compared without going through the HTML
+  printer. A section digest covers the arrays owned by the section (mixes,
+  inputs, curves, logical switches...) plus a digest of everything that is not
+  owned by any section (flight modes, gvars, sensors, the general settings...),
+  since the printers resolve names and references through the whole model.
+  This errs on the side of reporting a difference: two sections only compare
+  equal when everything they can possibly print is byte identical.
+*/
+class ModelDiff
+{
+  public:
+    enum Section {
+      SECTION_SETUP,
+      SECTION_CHECKLIST,
+      SECTION_TIMERS,
+      SECTION_FUNCTION_SWITCHES,
+      SECTION_MODULES,
+      SECTION_HELI,
+      SECTION_FLIGHT_MODES,
+      SECTION_INPUTS,
+      SECTION_MIXERS,
+      SECTION_OUTPUTS,
+      SECTION_CURVES,
+      SECTION_GVARS,
+      SECTION_LOGICAL_SWITCHES,
+      SECTION_GLOBAL_FUNCTIONS,
+      SECTION_SPECIAL_FUNCTIONS,
+      SECTION_TELEMETRY,
+      SECTION_SENSORS,
+      SECTION_TELEMETRY_SCREENS,
+      SECTION_COUNT
+    };
+
+    static constexpr quint32 ALL_SECTIONS = (1u << SECTION_COUNT) - 1;
+
+    struct Digest {
+      quint64 section[SECTION_COUNT];
+    };
+
+    typedef QPair<const ModelData *, const GeneralSettings *> Entry;
+
+    static Digest digest(const ModelData & model, const GeneralSettings & settings);
+
+    // digests of all entries, spread over the available cores
+    static QVector<Digest> digests(const QVector<Entry> & entries);
+
+    // bitmask of the sections (1 << Section) that are not the same in all digests
+    static quint32 differingSections(const QVector<Digest> & digests);
+
+    // bitmask of differing sections for every pair, spread over the available cores
+    static QVector<quint32> compare(const QVector<QPair<Entry, Entry>> & pairs);
+};
@@ -230,7 +230,8 @@ QString MultiModelPrinter::printTitle(const QString & label)
 }
 
 MultiModelPrinter::MultiModelPrinter(Firmware * firmware):
-  firmware(firmware)
+  firmware(firmware),
+  skipIdenticalSections(false)
 {
 }
 
@@ -249,6 +250,7 @@ void MultiModelPrinter::setModel(int idx, const ModelData * model, const General
 
   QPair<const ModelData *, ModelPrinter *> pair(model, new ModelPrinter(firmware, *generalSettings, *model));
   modelPrinterMap.insert(idx, pair);  // QMap.insert will replace any existing key
+  generalSettingsMap.insert(idx, generalSettings);
 }
 
 void MultiModelPrinter::setModel(int idx, const ModelData * model)
@@ -263,6 +265,18 @@ void MultiModelPrinter::clearModels()
       delete modelPrinterMap.value(i).second;
   }
   modelPrinterMap.clear();
+  generalSettingsMap.clear();
+}
+
+quint32 MultiModelPrinter::differingSections() const
+{
+  if (!skipIdenticalSections || modelPrinterMap.size() < 2)
+    return ModelDiff::ALL_SECTIONS;
+
+  QVector<ModelDiff::Entry> entries;
+  for (auto it = modelPrinterMap.constBegin(); it != modelPrinterMap.constEnd(); ++it)
+    entries.append(ModelDiff::Entry(it.value().first, generalSettingsMap.value(it.key())));
+  return ModelDiff::differingSections(ModelDiff::digests(entries));
 }
 
 QString MultiModelPrinter::print(QTextDocument * document)
@@ -272,38 +286,52 @@ QString MultiModelPrinter::print(QTextDocument * document)
   if (css.load(Stylesheet::StyleType::STYLE_TYPE_EFFECTIVE))
     document->setDefaultStyleSheet(css.text());
   QString str = "<table cellspacing='0' cellpadding='3' width='100%'>";   // attributes not settable via QT stylesheet
-  str.append(printSetup());
-  if (firmware->getCapability(HasDisplayText))
+  const quint32 differing = differingSections();
+  auto show = [differing](ModelDiff::Section section) { return (differing & (1u << section)) != 0; };
+  if (show(ModelDiff::SECTION_SETUP))
+    str.append(printSetup());
+  if (firmware->getCapability(HasDisplayText) && show(ModelDiff::SECTION_CHECKLIST))
     str.append(printChecklist());
-  if (firmware->getCapability(Timers)) {
+  if (firmware->getCapability(Timers) && show(ModelDiff::SECTION_TIMERS)) {
     str.append(printTimers());
   }
-  if (Boards::getCapability(firmware->getBoard(), Board::FunctionSwitches)) {
+  if (Boards::getCapability(firmware->getBoard(), Board::FunctionSwitches) && show(ModelDiff::SECTION_FUNCTION_SWITCHES)) {
     str.append(printFunctionSwitches());
   }
 
-  str.append(printModules());
-  if (firmware->getCapability(Heli))
+  if (show(ModelDiff::SECTION_MODULES))
+    str.append(printModules());
+  if (firmware->getCapability(Heli) && show(ModelDiff::SECTION_HELI))
     str.append(printHeliSetup());
-  if (firmware->getCapability(FlightModes))
+  if (firmware->getCapability(FlightModes) && show(ModelDiff::SECTION_FLIGHT_MODES))
     str.append(printFlightModes());
-  str.append(printInputs());
-  str.append(printMixers());
-  str.append(printOutputs());
-  str.append(printCurves(document));
-  if (firmware->getCapability(Gvars) && !firmware->getCapability(GvarsFlightModes))
+  if (show(ModelDiff::SECTION_INPUTS))
+    str.append(printInputs());
+  if (show(ModelDiff::SECTION_MIXERS))
+    str.append(printMixers());
+  if (show(ModelDiff::SECTION_OUTPUTS))
+    str.append(printOutputs());
+  if (show(ModelDiff::SECTION_CURVES))
+    str.append(printCurves(document));
+  if (firmware->getCapability(Gvars) && !firmware->getCapability(GvarsFlightModes) && show(ModelDiff::SECTION_GVARS))
     str.append(printGvars());
-  str.append(printLogicalSwitches());
-  if (firmware->getCapability(GlobalFunctions))
+  if (show(ModelDiff::SECTION_LOGICAL_SWITCHES))
+    str.append(printLogicalSwitches());
+  if (firmware->getCapability(GlobalFunctions) && show(ModelDiff::SECTION_GLOBAL_FUNCTIONS))
     str.append(printGlobalFunctions());
-  str.append(printSpecialFunctions());
+  if (show(ModelDiff::SECTION_SPECIAL_FUNCTIONS))
+    str.append(printSpecialFunctions());
   if (firmware->getCapability(Telemetry)) {
-    str.append(printTelemetry());
-    str.append(printSensors());
-    if (firmware->getCapability(TelemetryCustomScreens)) {
+    if (show(ModelDiff::SECTION_TELEMETRY))
+      str.append(printTelemetry());
+    if (show(ModelDiff::SECTION_SENSORS))
+      str.append(printSensors());
+    if (firmware->getCapability(TelemetryCustomScreens) && show(ModelDiff::SECTION_TELEMETRY_SCREENS)) {
       str.append(printTelemetryScreens());
     }
   }
+  if (differing != ModelDiff::ALL_SECTIONS)
+    str.append(printTitle(tr("Sections not shown are identical in all models")));
   str.append("</table>");
   return str;
 }
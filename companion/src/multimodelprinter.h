@@ -25,6 +25,7 @@
 #include <QTextDocument>
 #include "eeprominterface.h"
 #include "modelprinter.h"
+#include "modeldiff.h"
 
 class MultiModelPrinter: public QObject
 {
@@ -37,6 +38,8 @@ class MultiModelPrinter: public QObject
     void setModel(int idx, const ModelData * model, const GeneralSettings * generalSettings);
     void setModel(int idx, const ModelData * model);
     void clearModels();
+    // leave out the sections that are the same in all models
+    void setSkipIdenticalSections(bool skip) { skipIdenticalSections = skip; }
     QString print(QTextDocument * document);
 
   protected:
@@ -76,6 +79,10 @@ class MultiModelPrinter: public QObject
     Firmware * firmware;
     GeneralSettings defaultSettings;
     QMap<int, QPair<const ModelData *, ModelPrinter *> > modelPrinterMap;
+    QMap<int, const GeneralSettings *> generalSettingsMap;
+    bool skipIdenticalSections;
+
+    quint32 differingSections() const;
 
     QString printTitle(const QString & label);
     QString printSetup();
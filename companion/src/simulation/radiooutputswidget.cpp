@@ -38,8 +38,11 @@ RadioOutputsWidget::RadioOutputsWidget(SimulatorInterface * simulator, Firmware
   m_simulator(simulator),
   m_firmware(firmware),
   m_radioProfileId(g.sessionId()),
+  m_lastOutputsValid(false),
   ui(new Ui::RadioOutputsWidget)
 {
+  qRegisterMetaType<SimulatorInterface::TxOutputs>();
+
   ui->setupUi(this);
 
   restoreState();
@@ -48,10 +51,7 @@ RadioOutputsWidget::RadioOutputsWidget(SimulatorInterface * simulator, Firmware
   connect(ui->channelsScroll->horizontalScrollBar(), &QScrollBar::sliderMoved, ui->mixersScroll->horizontalScrollBar(), &QScrollBar::setValue);
   connect(ui->mixersScroll->horizontalScrollBar(), &QScrollBar::sliderMoved, ui->channelsScroll->horizontalScrollBar(), &QScrollBar::setValue);
 
-  connect(m_simulator, &SimulatorInterface::channelOutValueChange, this, &RadioOutputsWidget::onChannelOutValueChange);
-  connect(m_simulator, &SimulatorInterface::channelMixValueChange, this, &RadioOutputsWidget::onChannelMixValueChange);
-  connect(m_simulator, &SimulatorInterface::virtualSwValueChange, this, &RadioOutputsWidget::onVirtSwValueChange);
-  connect(m_simulator, &SimulatorInterface::gVarValueChange, this, &RadioOutputsWidget::onGVarValueChange);
+  connect(m_simulator, &SimulatorInterface::outputsChanged, this, &RadioOutputsWidget::onOutputsChanged);
   connect(m_simulator, &SimulatorInterface::phaseChanged, this, &RadioOutputsWidget::onPhaseChanged);
 }
 
@@ -76,6 +76,7 @@ void RadioOutputsWidget::changeEvent(QEvent *e)
 
 void RadioOutputsWidget::start()
 {
+  m_lastOutputsValid = false;
   setupChannelsDisplay(false);
   setupChannelsDisplay(true);
   setupGVarsDisplay();
@@ -303,63 +304,68 @@ QWidget * RadioOutputsWidget::createLogicalSwitch(QWidget * parent, int switchNo
   return swtch;
 }
 
-void RadioOutputsWidget::onChannelOutValueChange(quint8 index, qint32 value, qint32 limit)
+void RadioOutputsWidget::onOutputsChanged(const SimulatorInterface::TxOutputs & outputs)
 {
-  if (m_channelsMap.contains(index)) {
-    QPair<QLabel *, QSlider *> ch = m_channelsMap.value(index);
-    if (ch.second->maximum() != limit) {
-      ch.second->setMaximum(limit);
-      ch.second->setMinimum(-limit);
+  const bool all = !m_lastOutputsValid || outputs.chansLimit != m_lastOutputs.chansLimit ||
+                   outputs.ex_chansLimit != m_lastOutputs.ex_chansLimit;
+  QHash<int, QPair<QLabel *, QSlider *> >::const_iterator ch;
+  QHash<int, QLabel *>::const_iterator ls;
+  QHash<int, QHash<int, QLabel *> >::const_iterator gv;
+  QHash<int, QLabel *>::const_iterator fm;
+
+  for (ch = m_channelsMap.constBegin(); ch != m_channelsMap.constEnd(); ++ch) {
+    if (all || outputs.chans[ch.key()] != m_lastOutputs.chans[ch.key()])
+      updateChannel(ch.value(), outputs.chans[ch.key()], outputs.chansLimit);
+  }
+
+  for (ch = m_mixesMap.constBegin(); ch != m_mixesMap.constEnd(); ++ch) {
+    if (all || outputs.ex_chans[ch.key()] != m_lastOutputs.ex_chans[ch.key()])
+      updateChannel(ch.value(), outputs.ex_chans[ch.key()], outputs.ex_chansLimit);
+  }
+
+  for (ls = m_logicSwitchMap.constBegin(); ls != m_logicSwitchMap.constEnd(); ++ls) {
+    if (all || outputs.vsw[ls.key()] != m_lastOutputs.vsw[ls.key()])
+      updateLogicalSwitch(ls.value(), outputs.vsw[ls.key()]);
+  }
+
+  for (gv = m_globalVarsMap.constBegin(); gv != m_globalVarsMap.constEnd(); ++gv) {
+    for (fm = gv.value().constBegin(); fm != gv.value().constEnd(); ++fm) {
+      if (all || outputs.gvars[fm.key()][gv.key()] != m_lastOutputs.gvars[fm.key()][gv.key()])
+        updateGVar(fm.value(), outputs.gvars[fm.key()][gv.key()]);
     }
-    ch.first->setText(QString("%1%").arg(calcRESXto100(value)));
-    ch.second->setValue(qMin(limit, qMax(-limit, value)));
   }
+
+  m_lastOutputs = outputs;
+  m_lastOutputsValid = true;
 }
 
-void RadioOutputsWidget::onChannelMixValueChange(quint8 index, qint32 value, qint32 limit)
+void RadioOutputsWidget::updateChannel(QPair<QLabel *, QSlider *> ch, qint32 value, qint32 limit)
 {
-  if (m_mixesMap.contains(index)) {
-    QPair<QLabel *, QSlider *> ch = m_mixesMap.value(index);
-    if (ch.second->maximum() != limit) {
-      ch.second->setMaximum(limit);
-      ch.second->setMinimum(-limit);
-    }
-    ch.first->setText(QString("%1%").arg(calcRESXto100(value)));
-    ch.second->setValue(qMin(limit, qMax(-limit, value)));
+  if (ch.second->maximum() != limit) {
+    ch.second->setMaximum(limit);
+    ch.second->setMinimum(-limit);
   }
+  ch.first->setText(QString("%1%").arg(calcRESXto100(value)));
+  ch.second->setValue(qMin(limit, qMax(-limit, value)));
 }
 
-void RadioOutputsWidget::onVirtSwValueChange(quint8 index, qint32 value)
+void RadioOutputsWidget::updateLogicalSwitch(QLabel * ls, bool value)
 {
-  if (!m_logicSwitchMap.contains(index))
-    return;
-
-  QLabel * ls = m_logicSwitchMap.value(index);
   ls->setBackgroundRole(value ? QPalette::Dark : QPalette::Background);
   ls->setForegroundRole(value ? QPalette::BrightText : QPalette::WindowText);
   ls->setFrameShadow(value ? QFrame::Sunken : QFrame::Raised);
   QFont font = ls->font();
-  font.setBold((bool)value);
+  font.setBold(value);
   ls->setFont(font);
-  //qDebug() << index << value;
 }
 
-void RadioOutputsWidget::onGVarValueChange(quint8 index, qint32 value)
+void RadioOutputsWidget::updateGVar(QLabel * lbl, qint32 value)
 {
-  if (!m_globalVarsMap.contains(index))
-    return;
-
-  QHash<int, QLabel *> fmMap = m_globalVarsMap.value(index);
   SimulatorInterface::gVarMode_t gv(value);
-  QLabel * lbl;
-
-  if (fmMap.contains(gv.mode) && (lbl = fmMap.value(gv.mode))) {
-    GVarData gvar;
-    gvar.prec = gv.prec;
-    gvar.unit = gv.unit;
-    lbl->setText(QString::number(gv.value * gvar.multiplierGet(), 'f', gv.prec) + gvar.unitToString());
-  }
-  //qDebug() << index << value << gv.mode << gv.value << gv.prec << gv.unit;
+  GVarData gvar;
+  gvar.prec = gv.prec;
+  gvar.unit = gv.unit;
+  lbl->setText(QString::number(gv.value * gvar.multiplierGet(), 'f', gv.prec) + gvar.unitToString());
 }
 
 void RadioOutputsWidget::onPhaseChanged(qint32 phase, const QString &)
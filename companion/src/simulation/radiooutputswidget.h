@@ -56,10 +56,7 @@ class RadioOutputsWidget : public QWidget
   protected slots:
     void saveState();
     void restoreState();
-    void onChannelOutValueChange(quint8 index, qint32 value, qint32 limit);
-    void onChannelMixValueChange(quint8 index, qint32 value, qint32 limit);
-    void onVirtSwValueChange(quint8 index, qint32 value);
-    void onGVarValueChange(quint8 index, qint32 value);
+    void onOutputsChanged(const SimulatorInterface::TxOutputs & outputs);
     void onPhaseChanged(qint32 phase, const QString &);
 
   protected:
@@ -68,6 +65,9 @@ class RadioOutputsWidget : public QWidget
     void setupLsDisplay();
     void setupGVarsDisplay();
     QWidget * createLogicalSwitch(QWidget * parent, int switchNo);
+    void updateChannel(QPair<QLabel *, QSlider *> ch, qint32 value, qint32 limit);
+    void updateLogicalSwitch(QLabel * ls, bool value);
+    void updateGVar(QLabel * lbl, qint32 value);
 
     SimulatorInterface * m_simulator;
     Firmware * m_firmware;
@@ -77,6 +77,9 @@ class RadioOutputsWidget : public QWidget
     QHash<int, QLabel *> m_logicSwitchMap;                  // m_logicSwitchMap[lsIndex] = QLabel*
     QHash<int, QHash<int, QLabel *> > m_globalVarsMap;      // m_globalVarsMap[gvarIndex][fmodeIndex] = QLabel*
 
+    SimulatorInterface::TxOutputs m_lastOutputs;            // last snapshot painted, used to find changed values
+    bool m_lastOutputsValid;                                // false forces a full repaint on next snapshot
+
     int m_radioProfileId;
     int m_dataUpdateFreq;
 
@@ -33,6 +33,7 @@
 #include <QDir>
 #include <QLibrary>
 #include <QMap>
+#include <QVector>
 
 #define SIMULATOR_INTERFACE_HEARTBEAT_PERIOD    1000  // ms
 
@@ -58,18 +59,6 @@ class SimulatorInterface : public QObject
       INPUT_SRC_ENUM_COUNT
     };
 
-    enum OutputSourceType {
-      OUTPUT_SRC_NONE = 0,
-      OUTPUT_SRC_CHAN_OUT,
-      OUTPUT_SRC_CHAN_MIX,
-      OUTPUT_SRC_TRIM_VALUE,
-      OUTPUT_SRC_TRIM_RANGE,
-      OUTPUT_SRC_VIRTUAL_SW,
-      OUTPUT_SRC_PHASE,
-      OUTPUT_SRC_GVAR,
-      OUTPUT_SRC_ENUM_COUNT
-    };
-
     // only for data not available from Boards or Firmware, eg. compile-time options
     enum Capability {
       CAP_LUA,                // LUA
@@ -110,6 +99,8 @@ class SimulatorInterface : public QObject
 
       int16_t chans[CPN_MAX_CHNOUT];       // final channel outputs
       int16_t ex_chans[CPN_MAX_CHNOUT];    // raw mix outputs
+      qint32 chansLimit;                   // +/- range of chans[]
+      qint32 ex_chansLimit;                // +/- range of ex_chans[]
       qint32 gvars[CPN_MAX_FLIGHT_MODES][CPN_MAX_GVARS];
       int trims[CPN_MAX_TRIMS];            // Board::TrimAxes enum
       bool vsw[CPN_MAX_LOGICAL_SWITCHES];  // virtual/logic switches
@@ -118,6 +109,12 @@ class SimulatorInterface : public QObject
       // bool beep;
     };
 
+    // one step of sweepMixer()
+    struct MixerSweepPoint {
+      int16_t value;                       // position of the swept input
+      int16_t ex_chans[CPN_MAX_CHNOUT];    // raw mix outputs, same range as TxOutputs::ex_chans
+    };
+
     virtual ~SimulatorInterface() {}
 
     virtual QString name() = 0;
@@ -127,6 +124,10 @@ class SimulatorInterface : public QObject
     virtual uint8_t getSensorInstance(uint16_t id, uint8_t defaultValue = 0) = 0;
     virtual uint16_t getSensorRatio(uint16_t id) = 0;
     virtual const int getCapability(Capability cap) = 0;
+    // Evaluate the mixer of the running model in one flight mode for each position of an
+    // analog input in [from..to], the live outputs are left untouched
+    virtual QVector<MixerSweepPoint> sweepMixer(quint8 flightMode, quint8 input,
+                                                qint16 from, qint16 to, qint16 step) = 0;
 
   public slots:
 
@@ -148,6 +149,8 @@ class SimulatorInterface : public QObject
     virtual void lcdFlushed() = 0;
     virtual void setTrainerTimeout(uint16_t ms) = 0;
     virtual void sendTelemetry(const QByteArray data) = 0;
+    // protocol: 0 = S.Port, 1 = CRSF, 2 = Ghost; speed: 1 = real time, 0 = as fast as possible
+    virtual void replayTelemetry(const QString & filename, quint8 protocol, quint16 speed) = 0;
     virtual void setLuaStateReloadPermanentScripts() = 0;
     virtual void addTracebackDevice(QIODevice * device) = 0;
     virtual void removeTracebackDevice(QIODevice * device) = 0;
@@ -160,15 +163,15 @@ class SimulatorInterface : public QObject
     void runtimeError(const QString & error);
     void lcdChange(bool backlightEnable);
     void phaseChanged(qint8 phase, const QString & name);
-    void channelOutValueChange(quint8 index, qint32 value, qint32 limit);
-    void channelMixValueChange(quint8 index, qint32 value, qint32 limit);
-    void virtualSwValueChange(quint8 index, qint32 value);
+    // one snapshot per update tick when any channel, mix, logical switch or gvar changed,
+    // receivers compare against their own last copy to find what needs repainting
+    void outputsChanged(const SimulatorInterface::TxOutputs & outputs);
     void trimValueChange(quint8 index, qint32 value);
     void trimRangeChange(quint8 index, qint32 min, qint16 max);
-    void gVarValueChange(quint8 index, qint32 value);
-    void outputValueChange(int type, quint8 index, qint32 value);
 };
 
+Q_DECLARE_METATYPE(SimulatorInterface::TxOutputs)
+
 class SimulatorFactory {
 
   public:
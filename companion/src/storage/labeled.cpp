@@ -21,6 +21,7 @@
 #include "labeled.h"
 #include "firmwares/opentx/opentxinterface.h"
 #include "firmwares/edgetx/edgetxinterface.h"
+#include "yamlmodelloader.h"
 
 #include <regex>
 
@@ -256,6 +257,10 @@ bool LabelsStorageFormat::loadYaml(RadioData & radioData)
   if (hasLabels)
     radioData.models.resize(modelFiles.size());
 
+  // read the files here, the parsing is done on the thread pool
+  QVector<YamlModelLoader::File> pending;
+  int cached = 0;
+
   for (const auto& mc : modelFiles) {
     qDebug() << "Filename: " << mc.filename.c_str();
 
@@ -273,28 +278,30 @@ bool LabelsStorageFormat::loadYaml(RadioData & radioData)
       }
     }
 
-    QByteArray modelBuffer;
-    QString filename = "MODELS/" + QString::fromStdString(mc.filename);
-    if (!loadFile(modelBuffer, filename)) {
-      setError(tr("Cannot extract ") + filename);
-      return false;
-    }
-
     // Please note:
     //  ModelData() use memset to clear everything to 0
     //
     auto& model = radioData.models[modelIdx];
 
-    try {
-      if (!loadModelFromYaml(model,modelBuffer)) {
-        setError(tr("Cannot load ") + filename);
+    YamlModelLoader::File file;
+    file.model = &model;
+    file.name = "MODELS/" + QString::fromStdString(mc.filename);
+    file.size = 0;
+    if (!fileInfo(file.name, file.path, file.size, file.lastModified))
+      file.path.clear();
+
+    if (YamlModelLoader::lookup(file)) {
+      cached++;
+    }
+    else {
+      if (!loadFile(file.data, file.name)) {
+        setError(tr("Cannot extract ") + file.name);
         return false;
       }
-    } catch(const std::runtime_error& e) {
-      setError(tr("Cannot load ") + filename + ":\n" + QString(e.what()));
-      return false;
+      pending.append(file);
     }
 
+    // the parser does not touch these, safe to set before the model is parsed
     model.modelIndex = modelIdx;
     strncpy(model.filename, mc.filename.c_str(), sizeof(model.filename)-1);
 
@@ -307,6 +314,12 @@ bool LabelsStorageFormat::loadYaml(RadioData & radioData)
     modelIdx++;
   }
 
+  YamlModelLoader loader;
+  if (!loader.load(pending, cached, progressCallback)) {
+    setError(loader.error());
+    return false;
+  }
+
   // Add the labels in the models
   if (hasLabels) {
     radioData.addLabelsFromModels();
@@ -45,6 +45,8 @@ class LabelsStorageFormat : public StorageFormat
     virtual bool writeFile(const QByteArray & fileData, const QString & fileName) = 0;
     virtual bool getFileList(std::list<std::string>& filelist) = 0;
     virtual bool deleteFile(const QString & fileName) = 0;
+    // identifies a file for the model cache, false if it cannot be cached
+    virtual bool fileInfo(const QString & fileName, QString & path, qint64 & size, QDateTime & lastModified) { return false; }
 
     virtual bool loadBin(RadioData & radioData);
     virtual bool writeBin(const RadioData & radioData);
@@ -19,6 +19,7 @@
  */
 
 #include "sdcard.h"
+#include "yamlmodelloader.h"
 #include <QFile>
 #include <QDir>
 
@@ -53,6 +54,7 @@ bool SdcardFormat::writeFile(const QByteArray & data, const QString & filename)
   }
   file.write(data.data(), data.size());
   file.close();
+  YamlModelLoader::invalidate(QFileInfo(path).absoluteFilePath());
   qDebug() << "File" << path << "written, size:" << data.size();
   return true;
 }
@@ -78,10 +80,23 @@ bool SdcardFormat::deleteFile(const QString & filename)
     return false;
   }
 
+  YamlModelLoader::invalidate(QFileInfo(path).absoluteFilePath());
   qDebug() << "File" << path << "deleted";
   return true;
 }
 
+bool SdcardFormat::fileInfo(const QString & fileName, QString & path, qint64 & size, QDateTime & lastModified)
+{
+  QFileInfo info(this->filename + "/" + fileName);
+  if (!info.exists())
+    return false;
+
+  path = info.absoluteFilePath();
+  size = info.size();
+  lastModified = info.lastModified();
+  return true;
+}
+
 bool SdcardStorageFactory::probe(const QString & path)
 {
   return QDir(path).exists();
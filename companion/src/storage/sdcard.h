@@ -43,6 +43,7 @@ class SdcardFormat : public LabelsStorageFormat
     virtual bool writeFile(const QByteArray & fileData, const QString & fileName);
     virtual bool getFileList(std::list<std::string>& filelist);
     virtual bool deleteFile(const QString & fileName);
+    virtual bool fileInfo(const QString & fileName, QString & path, qint64 & size, QDateTime & lastModified);
 };
 
 class SdcardStorageFactory : public DefaultStorageFactory<SdcardFormat>
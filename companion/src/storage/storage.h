@@ -27,6 +27,8 @@
 #include <QString>
 #include <QDebug>
 
+#include <functional>
+
 enum StorageType
 {
   STORAGE_TYPE_UNKNOWN,
@@ -43,6 +45,9 @@ enum StorageType
 
 StorageType getStorageType(const QString & filename);
 
+// called with the number of models loaded so far, return false to cancel loading
+typedef std::function<bool(int done, int total)> StorageProgressCallback;
+
 class StorageFormat
 {
   Q_DECLARE_TR_FUNCTIONS(StorageFormat)
@@ -74,6 +79,11 @@ class StorageFormat
       return board;
     }
 
+    void setProgressCallback(const StorageProgressCallback & callback)
+    {
+      progressCallback = callback;
+    }
+
   protected:
     void setError(const QString & error)
     {
@@ -92,6 +102,7 @@ class StorageFormat
     QString _error;
     QString _warning;
     Board::Type board;
+    StorageProgressCallback progressCallback;
 };
 
 class StorageFactory
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "yamlmodelloader.h"
+#include "eeprominterface.h"
+#include "firmwares/edgetx/edgetxinterface.h"
+
+#include <stdexcept>
+
+namespace {
+
+struct CacheEntry {
+  qint64 size;
+  QDateTime lastModified;
+  Firmware * firmware;
+  ModelData model;
+};
+
+// a model is a few hundred kB, the least recently used models are dropped
+// once the cache holds that many bytes of parsed models
+constexpr int CACHE_MAX_BYTES = 64 * 1024 * 1024;
+
+typedef QSharedPointer<const CacheEntry> CacheEntryPtr;
+
+QMutex cacheMutex;
+QCache<QString, CacheEntryPtr> cache(CACHE_MAX_BYTES);
+
+void store(const YamlModelLoader::File & file)
+{
+  if (file.path.isEmpty())
+    return;
+
+  QSharedPointer<CacheEntry> entry(new CacheEntry);
+  entry->size = file.size;
+  entry->lastModified = file.lastModified;
+  entry->firmware = getCurrentFirmware();
+  entry->model = *file.model;
+
+  QMutexLocker locker(&cacheMutex);
+  cache.insert(file.path, new CacheEntryPtr(entry), sizeof(CacheEntry));
+}
+
+class ParseTask : public QRunnable
+{
+  public:
+    ParseTask(YamlModelLoader::File & file, QString & error, QAtomicInt & cancelled, QSemaphore & finished):
+      file(file),
+      error(error),
+      cancelled(cancelled),
+      finished(finished)
+    {
+    }
+
+    void run() override
+    {
+      if (!cancelled.loadAcquire()) {
+        try {
+          if (loadModelFromYaml(*file.model, file.data))
+            store(file);
+          else
+            error = QCoreApplication::translate("YamlModelLoader", "Cannot load ") + file.name;
+        } catch(const std::runtime_error& e) {
+          error = QCoreApplication::translate("YamlModelLoader", "Cannot load ") + file.name + ":\n" + QString(e.what());
+        }
+        file.data.clear();
+      }
+      finished.release();
+    }
+
+  private:
+    YamlModelLoader::File & file;
+    QString & error;
+    QAtomicInt & cancelled;
+    QSemaphore & finished;
+};
+
+}
+
+bool YamlModelLoader::lookup(File & file)
+{
+  if (file.path.isEmpty())
+    return false;
+
+  CacheEntryPtr entry;
+  {
+    QMutexLocker locker(&cacheMutex);
+    if (CacheEntryPtr * cached = cache.object(file.path))
+      entry = *cached;
+  }
+
+  if (!entry || entry->size != file.size || entry->lastModified != file.lastModified ||
+      entry->firmware != getCurrentFirmware())
+    return false;
+
+  *file.model = entry->model;
+  return true;
+}
+
+void YamlModelLoader::invalidate(const QString & path)
+{
+  QMutexLocker locker(&cacheMutex);
+  cache.remove(path);
+}
+
+bool YamlModelLoader::load(QVector<File> & files, int cached, const StorageProgressCallback & progress)
+{
+  const int total = files.size() + cached;
+  QVector<QString> errors(files.size());
+  QAtomicInt cancelled(0);
+  QSemaphore finished;
+
+  QThreadPool * pool = QThreadPool::globalInstance();
+  for (int i = 0; i < files.size(); i++)
+    pool->start(new ParseTask(files[i], errors[i], cancelled, finished));
+
+  // the tasks reference the files and errors, always wait for all of them
+  int done = 0;
+  while (done < files.size()) {
+    if (finished.tryAcquire(1, 50))
+      done++;
+    if (progress && !cancelled.loadAcquire() && !progress(cached + done, total))
+      cancelled.storeRelease(1);
+  }
+
+  if (cancelled.loadAcquire()) {
+    _error = tr("Loading cancelled");
+    return false;
+  }
+
+  for (const QString & error : errors) {
+    if (!error.isEmpty()) {
+      _error = error;
+      return false;
+    }
+  }
+
+  return true;
+}
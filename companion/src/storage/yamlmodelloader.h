@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#pragma once
+
+#include "storage.h"
+
+#include <QtCore>
+
+/*
+  Parses model YAML files concurrently on the global thread pool.
+
+  Models that were parsed before are kept in a process wide cache keyed by
+  their path and validated with the file size and modification time, so
+  opening the same SD card folder again only parses the files that changed.
+  The cache is bounded in bytes, least recently used models are dropped first.
+*/
+class YamlModelLoader
+{
+  Q_DECLARE_TR_FUNCTIONS(YamlModelLoader)
+
+  public:
+    struct File {
+      ModelData * model;       // destination, must stay valid until load() returns
+      QString name;            // used in error messages
+      QString path;            // cache key, empty if the file cannot be cached
+      qint64 size;
+      QDateTime lastModified;
+      QByteArray data;
+    };
+
+    // fill the model from the cache, true if the cached copy is still valid
+    static bool lookup(File & file);
+    // drop the cached copy after the file was written or deleted
+    static void invalidate(const QString & path);
+
+    // parse all files that are not cached, the first error is kept in error()
+    bool load(QVector<File> & files, int cached, const StorageProgressCallback & progress);
+
+    QString error() const { return _error; }
+
+  private:
+    QString _error;
+};
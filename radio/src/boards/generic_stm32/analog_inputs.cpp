@@ -77,12 +77,26 @@ static void adc_wait_completion()
   stm32_hal_adc_wait_completion(_ADC_adc, n_ADC, _ADC_inputs, n_inputs);
 }
 
+// The ADS79xx SPI ADC is read in adc_wait_completion(),
+// so it cannot be converted in the background
+#if defined(ADC_BACKGROUND_READ) && !defined(ADC_SPI)
+static bool adc_check_completion()
+{
+  return stm32_hal_adc_check_completion();
+}
+#endif
+
 const etx_hal_adc_driver_t _adc_driver = {
   _hal_inputs,
   _pot_default_config,
   adc_init,
   adc_start_read,
-  adc_wait_completion
+  adc_wait_completion,
+#if defined(ADC_BACKGROUND_READ) && !defined(ADC_SPI)
+  adc_check_completion,
+#else
+  nullptr,
+#endif
 };
 
 #if defined(PWM_STICKS)
@@ -74,6 +74,8 @@ void loadCurves()
     curveEnd[i] = tmp;
 
   }
+  invalidateCurves();
+
   if (showWarning) {
     POPUP_WARNING("Invalid curve data repaired", "check your curves, logic switches");
   }
@@ -100,6 +102,8 @@ static void curveMove_unsafe(uint8_t index, int8_t shift)
   while (index < MAX_CURVES) {
     curveEnd[index++] += shift;
   }
+
+  invalidateCurves();
 }
 
 bool moveCurve(uint8_t index, int8_t shift)
@@ -145,6 +149,8 @@ void curveClear(uint8_t index)
   if (shift != 0) {
     curveMove_unsafe(index, shift);
   }
+
+  invalidateCurves();
 }
 
 void curveMirror(uint8_t index)
@@ -158,6 +164,8 @@ void curveMirror(uint8_t index)
   // we only mirror Y axis: X axis does not change
   for (int i = 0; i < STD_CURVE_POINTS(curve.points); i++)
     points[i] = -points[i];
+
+  invalidateCurves();
 }
 
 bool isCurveUsed(uint8_t index)
@@ -228,6 +236,38 @@ int32_t compute_tangent(CurveHeader* crv, const int8_t* points, int i)
   return m;
 }
 
+// Tangents of the smooth curves, computed once and reused until the model
+// changes. curvesVersion is bumped on every change; a cache entry built from
+// an older version is recomputed on its next use.
+struct CurveTangents {
+  uint32_t version;
+  int32_t m[MAX_POINTS_PER_CURVE];
+};
+
+static CurveTangents curveTangents[MAX_CURVES];
+static uint32_t curvesVersion = 1;
+
+void invalidateCurves()
+{
+  curvesVersion++;
+}
+
+static const int32_t * getCurveTangents(uint8_t idx)
+{
+  CurveTangents & cache = curveTangents[idx];
+  uint32_t version = curvesVersion;
+  if (cache.version != version) {
+    CurveHeader & crv = g_model.curves[idx];
+    int8_t * points = curveAddress(idx);
+    uint8_t count = STD_CURVE_POINTS(crv.points);
+    for (int i = 0; i < count; i++) {
+      cache.m[i] = compute_tangent(&crv, points, i);
+    }
+    cache.version = version;
+  }
+  return cache.m;
+}
+
 /* The following is a hermite cubic spline.
    The basis functions can be found here:
    http://en.wikipedia.org/wiki/Cubic_Hermite_spline
@@ -239,43 +279,47 @@ int16_t hermite_spline(int16_t x, uint8_t idx)
   int8_t *points = curveAddress(idx);
   uint8_t count = STD_CURVE_POINTS(crv.points);
   bool custom = (crv.type == CURVE_TYPE_CUSTOM);
+  const int32_t * m = getCurveTangents(idx);
 
   if (x < -RESX)
     x = -RESX;
   else if (x > RESX)
     x = RESX;
 
-  for (int i=0; i<count-1; i++) {
-    int32_t p0x, p3x;
-    if (custom) {
-      p0x = (i>0 ? calc100toRESX(points[count+i-1]) : -RESX);
-      p3x = (i<count-2 ? calc100toRESX(points[count+i]) : RESX);
-    }
-    else {
-      p0x = -RESX + (i*2*RESX)/(count-1);
-      p3x = -RESX + ((i+1)*2*RESX)/(count-1);
-    }
-
-    if (x >= p0x && x <= p3x) {
-      int32_t p0y = calc100toRESX(points[i]);
-      int32_t p3y = calc100toRESX(points[i+1]);
-      int32_t m0 = compute_tangent(&crv, points, i);
-      int32_t m3 = compute_tangent(&crv, points, i+1);
-      int32_t y;
-      int32_t h = p3x - p0x;
-      int32_t t = (h > 0 ? (MMULT * (x - p0x)) / h : 0);
-      int32_t t2 = t * t / MMULT;
-      int32_t t3 = t2 * t / MMULT;
-      int32_t h00 = 2*t3 - 3*t2 + MMULT;
-      int32_t h10 = t3 - 2*t2 + t;
-      int32_t h01 = -2*t3 + 3*t2;
-      int32_t h11 = t3 - t2;
-      y = p0y * h00 + h * (m0 * h10 / MMULT) + p3y * h01 + h * (m3 * h11 / MMULT);
-      y /= MMULT;
-      return y;
+  int i;
+  int32_t p0x, p3x;
+  if (custom) {
+    for (i = 0; i < count - 2; i++) {
+      if (x <= calc100toRESX(points[count + i]))
+        break;
     }
+    p0x = (i > 0 ? calc100toRESX(points[count + i - 1]) : -RESX);
+    p3x = (i < count - 2 ? calc100toRESX(points[count + i]) : RESX);
   }
-  return 0;
+  else {
+    i = ((x + RESX) * (count - 1)) / (2 * RESX);
+    if (i > count - 2)
+      i = count - 2;
+    p0x = -RESX + (i*2*RESX)/(count-1);
+    p3x = -RESX + ((i+1)*2*RESX)/(count-1);
+  }
+
+  int32_t p0y = calc100toRESX(points[i]);
+  int32_t p3y = calc100toRESX(points[i+1]);
+  int32_t m0 = m[i];
+  int32_t m3 = m[i+1];
+  int32_t y;
+  int32_t h = p3x - p0x;
+  int32_t t = (h > 0 ? (MMULT * (x - p0x)) / h : 0);
+  int32_t t2 = t * t / MMULT;
+  int32_t t3 = t2 * t / MMULT;
+  int32_t h00 = 2*t3 - 3*t2 + MMULT;
+  int32_t h10 = t3 - 2*t2 + t;
+  int32_t h01 = -2*t3 + 3*t2;
+  int32_t h11 = t3 - t2;
+  y = p0y * h00 + h * (m0 * h10 / MMULT) + p3y * h01 + h * (m3 * h11 / MMULT);
+  y /= MMULT;
+  return y;
 }
 
 int intpol(int x, uint8_t idx) // -100, -75, -50, -25, 0 ,25 ,50, 75, 100
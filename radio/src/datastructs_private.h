@@ -383,7 +383,7 @@ PACK(struct TelemetrySensor {
   uint8_t  subId;
   uint8_t  type:1 ENUM(TelemetrySensorType); // 0=custom / 1=calculated
                    // user can choose what unit to display each value in
-  uint8_t  spare1:1 SKIP;
+  uint8_t  module:1; // owning module when links use separate namespaces
   uint8_t  unit:6;
   uint8_t  prec:2;
   uint8_t  autoOffset:1;
@@ -680,7 +680,7 @@ PACK(struct ModelData {
   uint8_t   showInstanceIds:1;
   uint8_t   checklistInteractive:1;
   NOBACKUP(uint8_t hatsMode:2 ENUM(HatsMode));
-  uint8_t   spare3:2 SKIP;  // padding to 8-bit aligment
+  uint8_t   telemetryLinkMode:2 ENUM(TelemetryLinkMode);
   int8_t    customThrottleWarningPosition;
   BeepANACenter beepANACenter;
   MixData   mixData[MAX_MIXERS] NO_IDX;
@@ -67,15 +67,24 @@
 #define TT_PAGE_MAGIC                  0xEF87364A
 #define TT_RECORDS_PER_PAGE            1024
 
+// The tuning parameters below can be overridden from the build,
+// see the FrFTL tests for the resulting write amplification and wear
+
 // The multiplier for cache buffers, min recommendation is 2
+#if !defined(BUFFER_SIZE_MULTIPLIER)
 #define BUFFER_SIZE_MULTIPLIER         4
+#endif
 
 // Will cap the buffer size to this when exceeded
+#if !defined(MAX_BUFFER_SIZE)
 #define MAX_BUFFER_SIZE               64
+#endif
 
 // Reserve pages to minimize the erase cycles when the FS is full,
 // should be at least 2 times of BUFFER_SIZE_MULTIPLIER
+#if !defined(RESERVED_PAGES_MULTIPLIER)
 #define RESERVED_PAGES_MULTIPLIER      16
+#endif
 
 #define LOCKED   1
 #define UNLOCKED 0
@@ -163,6 +172,66 @@ static void setPhysicalPageState(FrFTL* ftl, uint16_t physicalPageNo,
 }
 
 
+// Returns a mask with bit 2*i set for every page i of a state word in the given state
+static inline uint32_t pageStateMask(uint32_t word, PhysicalPageState state)
+{
+  uint32_t lo = (state & 1) ? word : ~word;
+  uint32_t hi = (state & 2) ? word >> 1 : ~(word >> 1);
+  return lo & hi & 0x55555555;
+}
+
+// Finds the first page from 'from' onwards (wrapping around) which is in
+// (match = true) or not in (match = false) the given state, 16 pages at a time
+static uint16_t findPhysicalPage(FrFTL* ftl, uint16_t from,
+                                 PhysicalPageState state, bool match)
+{
+  uint32_t words = (ftl->physicalPageCount + 15) / 16;
+  uint32_t idx = from >> 4;
+  uint32_t skipMask = (1u << ((from & 0xf) * 2)) - 1;
+
+  for (uint32_t n = 0; n <= words; n++) {
+    uint32_t mask = pageStateMask(ftl->physicalPageState[idx], state);
+    if (!match) {
+      mask ^= 0x55555555;
+    }
+    if (n == 0) {
+      mask &= ~skipMask;
+    }
+    if (mask) {
+      uint32_t physicalPageNo = idx * 16 + __builtin_ctz(mask) / 2;
+      if (physicalPageNo < ftl->physicalPageCount) {
+        return physicalPageNo;
+      }
+    }
+    if (++idx >= words) {
+      idx = 0;
+    }
+  }
+
+  return 0xffff;
+}
+
+// Pages released since the last sync are still referenced by the TT pages
+// in flash: they stay USED, and so can't be reallocated, until the new TT
+// pages have been programmed
+static void releasePhysicalPage(FrFTL* ftl, uint16_t physicalPageNo)
+{
+  ftl->releasedPages[physicalPageNo >> 5] |= 1u << (physicalPageNo & 0x1f);
+}
+
+static void commitReleasedPages(FrFTL* ftl)
+{
+  uint32_t words = (ftl->physicalPageCount + 31) / 32;
+  for (uint32_t i = 0; i < words; i++) {
+    uint32_t released = ftl->releasedPages[i];
+    while (released) {
+      setPhysicalPageState(ftl, i * 32 + __builtin_ctz(released), ERASE_REQUIRED);
+      released &= released - 1;
+    }
+    ftl->releasedPages[i] = 0;
+  }
+}
+
 static const uint16_t crc16_ccitt_start = 0xFFFF;
 
 static inline uint16_t crc16_x25_ccitt(const void* buf, uint32_t len) {
@@ -426,14 +495,52 @@ static bool hasFreeBuffers(FrFTL* ftl, uint16_t bufferCount)
   return false;
 }
 
-static bool readPhysicalSector(FrFTL* ftl, uint8_t* buffer,
-                               uint16_t logicalPageNo, uint16_t physicalPageNo,
-                               uint8_t pageSectorNo)
+static bool readPhysicalSectors(FrFTL* ftl, uint8_t* buffer,
+                                uint16_t logicalPageNo, const PageInfo* pageInfo,
+                                uint8_t pageSectorNo, uint8_t noOfSectors)
 {
-  PageBuffer* pageBuffer = loadPhysicalPageInBuffer(ftl, logicalPageNo, physicalPageNo);
-  if (!pageBuffer) return false;
+  uint8_t sectMask = ((1 << noOfSectors) - 1) << pageSectorNo;
+  if ((pageInfo->sectStatus & sectMask) == sectMask) {
+    // Sectors never written, return init content
+    memset(buffer, 0xff, noOfSectors * SECTOR_SIZE);
+    return true;
+  }
+
+  // Buffered page may hold changes not programmed yet, so it always wins.
+  // A whole page not in buffer is read straight from flash to avoid
+  // flushing the cached TT pages with streamed data.
+  PageBuffer* pageBuffer = findPhysicalPageInBuffer(ftl, pageInfo->physicalPageNo);
+  if (!pageBuffer && noOfSectors < SECTORS_PER_PAGE) {
+    pageBuffer = loadPhysicalPageInBuffer(ftl, logicalPageNo, pageInfo->physicalPageNo);
+    if (!pageBuffer) return false;
+  }
+
+  const FrFTLOps* cb = ftl->callbacks;
+  uint8_t i = pageSectorNo;
+  uint8_t end = pageSectorNo + noOfSectors;
+  while (i < end) {
+    // Coalesce runs of sectors in the same written state
+    bool written = (pageInfo->sectStatus & (1 << i)) == 0;
+    uint8_t count = 1;
+    while (i + count < end &&
+           ((pageInfo->sectStatus & (1 << (i + count))) == 0) == written) {
+      count++;
+    }
+
+    uint32_t len = count * SECTOR_SIZE;
+    if (!written) {
+      memset(buffer, 0xff, len);
+    } else if (pageBuffer) {
+      memcpy(buffer, pageBuffer->page.data + i * SECTOR_SIZE, len);
+    } else if (!cb->flashRead(pageInfo->physicalPageNo * PAGE_SIZE + i * SECTOR_SIZE,
+                              buffer, len)) {
+      return false;
+    }
+
+    buffer += len;
+    i += count;
+  }
 
-  memcpy(buffer, pageBuffer->page.data + pageSectorNo * SECTOR_SIZE, SECTOR_SIZE);
   return true;
 }
 
@@ -521,19 +628,13 @@ static bool updatePageInfo(FrFTL* ftl, PageInfo* pageInfo,
 
 static uint16_t allocatePhysicalPage(FrFTL* ftl)
 {
-  uint16_t lookupCount = 0;
-  while (getPhysicalPageState(ftl, ftl->writeFrontier) == USED) {
-    ftl->writeFrontier++;
-    if (ftl->writeFrontier >= ftl->physicalPageCount) {
-      ftl->writeFrontier = 0;
-    }
-    lookupCount++;
-    if (lookupCount > ftl->physicalPageCount) {
-      return 0xffff;  // BUG
-    }
+  uint16_t physicalPageNo =
+      findPhysicalPage(ftl, ftl->writeFrontier, USED, false);
+  if (physicalPageNo == 0xffff) {
+    return 0xffff;  // BUG
   }
 
-  uint16_t physicalPageNo = ftl->writeFrontier++;
+  ftl->writeFrontier = physicalPageNo + 1;
   if (ftl->writeFrontier >= ftl->physicalPageCount) {
     ftl->writeFrontier = 0;
   }
@@ -558,19 +659,20 @@ static bool programPage(FrFTL* ftl, PageBuffer* buffer, bool doErase)
   }
 
   // Sector by sector programming:
-  // As flash requires 256 bytes per program command, it will be more efficient to program by sector
-  uint8_t* dataPtr = buffer->page.data;
-  for (uint8_t i = 0; i < SECTORS_PER_PAGE; i++)
+  // As flash requires 256 bytes per program command, it will be more efficient to program by sector.
+  // The header of TT pages is in the first sector, which is programmed last: a TT page
+  // is only recognized once complete, should the power be lost in the middle.
+  for (uint8_t n = 1; n <= SECTORS_PER_PAGE; n++)
   {
+    uint8_t i = n % SECTORS_PER_PAGE;
     uint8_t sectMask = 1 << i;
     if ((buffer->sectorProgramRequired & sectMask) != 0) {
-      if (!cb->flashProgram(pageAddr, dataPtr, SECTOR_SIZE))
+      if (!cb->flashProgram(pageAddr + i * SECTOR_SIZE,
+                            buffer->page.data + i * SECTOR_SIZE, SECTOR_SIZE))
       {
         return false;
       }
     }
-    pageAddr += SECTOR_SIZE;
-    dataPtr += SECTOR_SIZE;
   }
 
   return true;
@@ -603,7 +705,7 @@ static bool programPageInBuffer(FrFTL* ftl, PageBuffer* buffer)
     case RELOCATE_ERASE_PROGRAM:
       // Reprogram
       oldPhysicalPageNo = buffer->physicalPageNo;
-      setPhysicalPageState(ftl, oldPhysicalPageNo, ERASE_REQUIRED);
+      releasePhysicalPage(ftl, oldPhysicalPageNo);
       removePageFromHashTable(ftl, oldPhysicalPageNo);
       buffer->physicalPageNo = allocatePhysicalPage(ftl);
       if (buffer->physicalPageNo == 0xffff) {
@@ -731,6 +833,9 @@ bool ftlSync(FrFTL* ftl)
     mttBuffer->pMode = NONE;
   }
 
+  // New TT pages in place, the pages released meanwhile can be reused
+  commitReleasedPages(ftl);
+
   return true;
 }
 
@@ -825,30 +930,41 @@ bool ftlWrite(FrFTL* ftl, uint32_t startSectorNo, uint32_t noOfSectors,
   return true;
 }
 
-bool ftlRead(FrFTL* ftl, uint32_t sectorNo, uint8_t* buffer)
+bool ftlRead(FrFTL* ftl, uint32_t startSectorNo, uint32_t noOfSectors,
+             uint8_t* buf)
 {
-  //  doGC(ftl, ftl->ttPageCount, 1);
-  if (sectorNo >= ftl->usableSectorCount) {
+  if (startSectorNo + noOfSectors > ftl->usableSectorCount) {
     return false;
   }
 
-  uint16_t logicalPageNo = sectorNo / SECTORS_PER_PAGE + ftl->ttPageCount;
-  uint8_t pageSectorNo = sectorNo % SECTORS_PER_PAGE;
+  uint32_t sectorNo = startSectorNo;
+  while (noOfSectors > 0) {
+    uint16_t logicalPageNo = sectorNo / SECTORS_PER_PAGE + ftl->ttPageCount;
+    uint8_t pageSectorNo = sectorNo % SECTORS_PER_PAGE;
 
-  // Read page info
-  PageInfo pageInfo;
-  readPageInfo(ftl, &pageInfo, logicalPageNo);
+    // All the sectors on the same page are served by one lookup
+    uint8_t count = SECTORS_PER_PAGE - pageSectorNo;
+    if (count > noOfSectors) {
+      count = noOfSectors;
+    }
 
-  // Check if sector written before
-  uint8_t sectMask = 1 << pageSectorNo;
-  if ((pageInfo.sectStatus & sectMask) != 0) {
-    // Sector never write, return init content
-    memset(buffer, 0xff, SECTOR_SIZE);
-    return true;
+    // Read page info
+    PageInfo pageInfo;
+    if (!readPageInfo(ftl, &pageInfo, logicalPageNo)) {
+      return false;
+    }
+
+    if (!readPhysicalSectors(ftl, buf, logicalPageNo, &pageInfo, pageSectorNo,
+                             count)) {
+      return false;
+    }
+
+    noOfSectors -= count;
+    sectorNo += count;
+    buf += count * SECTOR_SIZE;
   }
 
-  return readPhysicalSector(ftl, buffer, logicalPageNo,
-			    pageInfo.physicalPageNo, pageSectorNo);
+  return true;
 }
 
 bool ftlTrim(FrFTL* ftl, uint32_t startSectorNo, uint32_t noOfSectors)
@@ -890,7 +1006,7 @@ bool ftlTrim(FrFTL* ftl, uint32_t startSectorNo, uint32_t noOfSectors)
         pageInfo.sectStatus |= sectMask;
         if (pageInfo.sectStatus == 0xff) {
           // Free whole page
-          setPhysicalPageState(ftl, pageInfo.physicalPageNo, ERASE_REQUIRED);
+          releasePhysicalPage(ftl, pageInfo.physicalPageNo);
           removePageFromHashTable(ftl, pageInfo.physicalPageNo);
           pageInfo.physicalPageNo = 0xffff;     // Invalidate page info
           dataBuffer->physicalPageNo = 0xffff;  // Invalidate buffer
@@ -923,6 +1039,38 @@ bool ftlTrim(FrFTL* ftl, uint32_t startSectorNo, uint32_t noOfSectors)
   return true;
 }
 
+bool ftlGarbageCollect(FrFTL* ftl, uint16_t maxPages)
+{
+  // Pages released since the last sync may still be referenced by the
+  // TT pages in flash, nothing can be erased until all changes are programmed
+  if (!hasFreeBuffers(ftl, ftl->pageBufferSize)) {
+    return true;
+  }
+
+  if (!ftl->physicalPageStateResolved) {
+    resolveUnknownState(ftl, maxPages);
+    return true;
+  }
+
+  // Erase released pages ahead of the write frontier,
+  // so that allocating them later does not stall on erasing
+  const FrFTLOps* cb = ftl->callbacks;
+  while (maxPages-- > 0) {
+    uint16_t physicalPageNo =
+        findPhysicalPage(ftl, ftl->writeFrontier, ERASE_REQUIRED, true);
+    if (physicalPageNo == 0xffff) {
+      return false;
+    }
+
+    if (!cb->flashErase(physicalPageNo * PAGE_SIZE)) {
+      return true;
+    }
+    setPhysicalPageState(ftl, physicalPageNo, ERASED);
+  }
+
+  return findPhysicalPage(ftl, ftl->writeFrontier, ERASE_REQUIRED, true) != 0xffff;
+}
+
 static void initPageBuffer(FrFTL* ftl)
 {
   // Init page buffer
@@ -1133,6 +1281,9 @@ bool ftlInit(FrFTL* ftl, const FrFTLOps* cb, uint16_t flashSizeInMB)
   ftl->physicalPageState = (uint32_t*)calloc(stateSize, sizeof(uint32_t));
   ftl->physicalPageStateResolved = false;
   ftl->memoryUsed += stateSize * sizeof(uint32_t);
+  uint32_t releasedSize = (ftl->physicalPageCount + 31) / 32;
+  ftl->releasedPages = (uint32_t*)calloc(releasedSize, sizeof(uint32_t));
+  ftl->memoryUsed += releasedSize * sizeof(uint32_t);
   ftl->pageBufferSize = ftl->ttPageCount * BUFFER_SIZE_MULTIPLIER;
   if (ftl->pageBufferSize > MAX_BUFFER_SIZE) {
     ftl->pageBufferSize = MAX_BUFFER_SIZE;
@@ -1151,5 +1302,6 @@ void ftlDeInit(FrFTL* ftl)
 {
   free(ftl->pageBuffer);
   free(ftl->physicalPageState);
+  free(ftl->releasedPages);
   free(ftl->hashTable);
 }
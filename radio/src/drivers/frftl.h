@@ -59,6 +59,7 @@ typedef struct {
   uint32_t usableSectorCount;
   uint16_t writeFrontier;
   uint32_t* physicalPageState;
+  uint32_t* releasedPages;     // released since the last sync
   bool physicalPageStateResolved;
   uint16_t pageBufferSize;
   void *pageBuffer;
@@ -72,11 +73,15 @@ bool ftlInit(FrFTL* ftl, const FrFTLOps* cb, uint16_t flashSizeInMB);
 void ftlDeInit(FrFTL* ftl);
 
 bool ftlWrite(FrFTL* ftl, uint32_t startSectorNo, uint32_t noOfSectors, const uint8_t* buf);
-bool ftlRead(FrFTL* ftl, uint32_t sectorNo, uint8_t* buffer);
+bool ftlRead(FrFTL* ftl, uint32_t startSectorNo, uint32_t noOfSectors, uint8_t* buf);
 
 bool ftlTrim(FrFTL* ftl, uint32_t startSectorNo, uint32_t noOfSectors);
 bool ftlSync(FrFTL* ftl);
 
+// Erase released pages in advance, to be called when the storage is idle.
+// Returns true if there is still work left.
+bool ftlGarbageCollect(FrFTL* ftl, uint16_t maxPages);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
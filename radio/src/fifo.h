@@ -23,6 +23,7 @@
 #define _FIFO_H_
 
 #include <inttypes.h>
+#include <string.h>
 
 template <class T, int N>
 class Fifo
@@ -104,6 +105,84 @@ class Fifo
       return fifo;
     }
 
+    // Bulk operations
+    //
+    // There must be a single producer (push / write / reserveContiguous +
+    // publish) and a single consumer (pop / read / peekContiguous + commit).
+    // Elements are copied before the index is published, so the other side
+    // never sees an index covering data that is not there yet.
+
+    // Copies up to len elements into the fifo, returns how many were written
+    uint32_t write(const T * data, uint32_t len)
+    {
+      uint32_t w = widx;
+      uint32_t count = N - 1 - ((N + w - ridx) & (N - 1));
+      if (len < count) count = len;
+      if (count == 0) return 0;
+
+      uint32_t first = N - w;
+      if (first > count) first = count;
+      memcpy(&fifo[w], data, first * sizeof(T));
+      memcpy(&fifo[0], data + first, (count - first) * sizeof(T));
+
+      __sync_synchronize();
+      widx = (w + count) & (N - 1);
+      return count;
+    }
+
+    // Copies up to len elements out of the fifo, returns how many were read
+    uint32_t read(T * data, uint32_t len)
+    {
+      uint32_t r = ridx;
+      uint32_t count = (N + widx - r) & (N - 1);
+      if (len < count) count = len;
+      if (count == 0) return 0;
+
+      __sync_synchronize();
+      uint32_t first = N - r;
+      if (first > count) first = count;
+      memcpy(data, &fifo[r], first * sizeof(T));
+      memcpy(data + first, &fifo[0], (count - first) * sizeof(T));
+
+      __sync_synchronize();
+      ridx = (r + count) & (N - 1);
+      return count;
+    }
+
+    // Returns the number of elements readable in place from data, up to
+    // the end of the buffer. Release them with commit().
+    uint32_t peekContiguous(const T *& data) const
+    {
+      uint32_t r = ridx;
+      uint32_t w = widx;
+      __sync_synchronize();
+      data = &fifo[r];
+      return (w >= r) ? w - r : N - r;
+    }
+
+    void commit(uint32_t n)
+    {
+      __sync_synchronize();
+      ridx = (ridx + n) & (N - 1);
+    }
+
+    // Returns the number of elements writable in place at data, up to the
+    // end of the buffer. Make them visible to the consumer with publish().
+    uint32_t reserveContiguous(T *& data)
+    {
+      uint32_t w = widx;
+      uint32_t r = ridx;
+      data = &fifo[w];
+      if (r > w) return r - w - 1;
+      return (r == 0) ? N - 1 - w : N - w;
+    }
+
+    void publish(uint32_t n)
+    {
+      __sync_synchronize();
+      widx = (widx + n) & (N - 1);
+    }
+
   protected:
     T fifo[N];
     volatile uint32_t widx;
@@ -88,6 +88,26 @@ extern int16_t channelOutputs[MAX_OUTPUT_CHANNELS];
 typedef uint16_t BeepANACenter;
 extern BeepANACenter bpanaCenter;
 
+// Transient mixer data, everything evalFlightModeMixes() writes to. Saving
+// and restoring it lets off-line evaluations (e.g. input sweeps) run on the
+// current model without disturbing the live outputs.
+struct MixerState {
+  int8_t virtualInputsTrims[MAX_INPUTS];
+  int16_t anas[MAX_INPUTS];
+  int16_t trims[MAX_TRIMS];
+  int32_t chans[MAX_OUTPUT_CHANNELS];
+  int32_t act[MAX_MIXERS];
+  SwOn swOn[MAX_MIXERS];
+  int16_t calibratedAnalogs[MAX_ANALOG_INPUTS];
+  uint32_t anaFilt[MAX_ANALOG_INPUTS];
+#if defined(HELI)
+  int16_t cyc_anas[3];
+#endif
+  BeepANACenter bpanaCenter;
+  uint8_t mixWarning;
+  uint8_t currentFlightMode;
+};
+
 extern uint8_t s_mixer_first_run_done;
 
 extern int16_t calibratedAnalogs[MAX_ANALOG_INPUTS];
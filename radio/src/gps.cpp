@@ -38,6 +38,7 @@
  */
 
 #include "opentx.h"
+#include "gps_ubx.h"
 #include <ctype.h>
 
 gpsdata_t gpsData;
@@ -308,9 +309,132 @@ bool gpsNewFrameNMEA(char c)
   return frameOK;
 }
 
+static UbxParser ubxParser;
+static tmr10ms_t lastUbxFrame = 0;
+
+#if GPS_UBX_RATE_HZ > 0
+/*
+  Switch a u-blox receiver from NMEA to UBX NAV-PVT:
+    - the port keeps its baudrate, its output becomes UBX only
+    - one NAV-PVT per navigation solution
+    - GPS_UBX_RATE_HZ navigation solutions per second
+  Other receivers ignore these frames and keep sending NMEA.
+*/
+static void gpsConfigureUBX()
+{
+  static const uint8_t cfgPrt[] = {
+    0x01,                                   // portID: UART1
+    0x00,                                   // reserved
+    0x00, 0x00,                             // txReady
+    0xD0, 0x08, 0x00, 0x00,                 // mode: 8N1
+    (uint8_t)(GPS_USART_BAUDRATE),
+    (uint8_t)(GPS_USART_BAUDRATE >> 8),
+    (uint8_t)(GPS_USART_BAUDRATE >> 16),
+    (uint8_t)(GPS_USART_BAUDRATE >> 24),    // baudRate
+    0x03, 0x00,                             // inProtoMask: UBX + NMEA
+    0x01, 0x00,                             // outProtoMask: UBX
+    0x00, 0x00,                             // flags
+    0x00, 0x00,                             // reserved
+  };
+  static const uint8_t cfgMsg[] = {
+    UBX_CLASS_NAV, UBX_NAV_PVT,
+    0x01,                                   // rate on the current port
+  };
+  static const uint8_t cfgRate[] = {
+    (uint8_t)(1000 / GPS_UBX_RATE_HZ),
+    (uint8_t)((1000 / GPS_UBX_RATE_HZ) >> 8), // measRate (ms)
+    0x01, 0x00,                             // navRate
+    0x01, 0x00,                             // timeRef: GPS
+  };
+
+  uint8_t frame[sizeof(cfgPrt) + UBX_FRAME_OVERHEAD];
+
+  TRACE("gps> UBX NAV-PVT %dHz", GPS_UBX_RATE_HZ);
+  gpsSendFrame(frame, ubxBuildFrame(frame, UBX_CLASS_CFG, UBX_CFG_MSG,
+                                    cfgMsg, sizeof(cfgMsg)));
+  gpsSendFrame(frame, ubxBuildFrame(frame, UBX_CLASS_CFG, UBX_CFG_RATE,
+                                    cfgRate, sizeof(cfgRate)));
+  gpsSendFrame(frame, ubxBuildFrame(frame, UBX_CLASS_CFG, UBX_CFG_PRT,
+                                    cfgPrt, sizeof(cfgPrt)));
+}
+#endif
+
+// NAV-PVT fields are read straight from the parser buffer
+static bool gpsNewFrameUBX(const uint8_t* payload)
+{
+  uint8_t fixType = ubxU1(payload, UBX_NAV_PVT_FIX_TYPE);
+  uint8_t flags = ubxU1(payload, UBX_NAV_PVT_FLAGS);
+  bool fix = (flags & UBX_NAV_PVT_FLAGS_FIX_OK) &&
+             fixType >= UBX_NAV_PVT_FIX_2D;
+
+  gpsData.fix = fix;
+  gpsData.numSat = ubxU1(payload, UBX_NAV_PVT_NUM_SV);
+  // NAV-PVT has no HDOP: PDOP is never smaller
+  gpsData.hdop = ubxU2(payload, UBX_NAV_PVT_PDOP);
+
+  if (fix) {
+    int32_t altitude = ubxI4(payload, UBX_NAV_PVT_HMSL) / 1000;
+    __disable_irq();    // do the atomic update of lat/lon
+    gpsData.latitude = ubxI4(payload, UBX_NAV_PVT_LAT) / 10;
+    gpsData.longitude = ubxI4(payload, UBX_NAV_PVT_LON) / 10;
+    gpsData.altitude = altitude > 0 ? altitude : 0;
+    __enable_irq();
+  }
+
+  gpsData.speed = ubxI4(payload, UBX_NAV_PVT_GSPEED) / 10;  // cm/s, as NMEA
+  gpsData.groundCourse = ubxI4(payload, UBX_NAV_PVT_HEAD_MOT) / 10000;
+
+#if defined(RTCLOCK)
+  // set RTC clock if needed, once a second is enough
+  static uint8_t lastSec = 0xFF;
+  uint8_t valid = ubxU1(payload, UBX_NAV_PVT_VALID);
+  uint8_t sec = ubxU1(payload, UBX_NAV_PVT_SEC);
+  if (g_eeGeneral.adjustRTC && fix && sec != lastSec &&
+      (valid & UBX_NAV_PVT_VALID_DATE) && (valid & UBX_NAV_PVT_VALID_TIME)) {
+    lastSec = sec;
+    rtcAdjust(ubxU2(payload, UBX_NAV_PVT_YEAR),
+              ubxU1(payload, UBX_NAV_PVT_MONTH),
+              ubxU1(payload, UBX_NAV_PVT_DAY),
+              ubxU1(payload, UBX_NAV_PVT_HOUR),
+              ubxU1(payload, UBX_NAV_PVT_MIN), sec);
+  }
+#endif
+
+  return true;
+}
+
 bool gpsNewFrame(uint8_t c)
 {
-  return gpsNewFrameNMEA(c);
+  // UBX frames are binary and would only disturb the NMEA parser
+  bool inFrame = ubxParserBusy(&ubxParser);
+  UbxParseResult res = ubxParseByte(&ubxParser, c);
+  if (!inFrame && !ubxParserBusy(&ubxParser)) {
+    bool frameOK = gpsNewFrameNMEA(c);
+#if GPS_UBX_RATE_HZ > 0
+    // still NMEA: (re)configure the receiver, e.g. after a power cycle
+    static tmr10ms_t lastUbxConfig = 0;
+    tmr10ms_t now = get_tmr10ms();
+    if (frameOK && now - lastUbxFrame > 200 && now - lastUbxConfig > 200) {
+      lastUbxConfig = now;
+      gpsConfigureUBX();
+    }
+#endif
+    return frameOK;
+  }
+
+  if (res == UBX_PARSE_ERROR) {
+    gpsData.errorCount++;
+  }
+  else if (res == UBX_PARSE_FRAME) {
+    gpsData.packetCount++;
+    if (ubxParser.msgClass == UBX_CLASS_NAV &&
+        ubxParser.msgId == UBX_NAV_PVT &&
+        ubxParser.length == UBX_NAV_PVT_LEN) {
+      lastUbxFrame = get_tmr10ms();
+      return gpsNewFrameUBX(ubxParser.payload);
+    }
+  }
+  return false;
 }
 
 void gpsNewData(uint8_t c)
@@ -380,3 +504,16 @@ void gpsSendFrame(const char * frame)
 
   TRACE("*%02x", parity);
 }
+
+void gpsSendFrame(const uint8_t * frame, uint16_t length)
+{
+  if (!gpsSerialDrv) return;
+
+  auto _sendByte = gpsSerialDrv->sendByte;
+  if (!_sendByte) return;
+
+  // send binary frame as is
+  while (length--) {
+    _sendByte(gpsSerialCtx, *frame++);
+  }
+}
@@ -24,6 +24,16 @@
 
 #include <inttypes.h>
 
+// UBX NAV-PVT rate requested from u-blox receivers, 0 keeps them in NMEA.
+// A NAV-PVT frame takes 1000 bits on the wire: use at most half the link.
+#if !defined(GPS_UBX_RATE_HZ)
+  #if GPS_USART_BAUDRATE / 2000 > 25
+    #define GPS_UBX_RATE_HZ 25
+  #else
+    #define GPS_UBX_RATE_HZ (GPS_USART_BAUDRATE / 2000)
+  #endif
+#endif
+
 struct gpsdata_t
 {
   int32_t longitude;              // degrees * 1.000.000
@@ -50,7 +60,10 @@ void gpsSetSerialDriver(void* ctx, const etx_serial_driver_t* drv);
 // Periodic processing
 void gpsWakeup();
 
-// Send a 0-terminated frame
+// Send a 0-terminated NMEA frame, checksum and CRLF are added
 void gpsSendFrame(const char * frame);
 
+// Send a binary frame (UBX)
+void gpsSendFrame(const uint8_t * frame, uint16_t length);
+
 #endif // _GPS_H_
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "gps_ubx.h"
+
+enum UbxParserState {
+  UBX_STATE_SYNC1,
+  UBX_STATE_SYNC2,
+  UBX_STATE_CLASS,
+  UBX_STATE_ID,
+  UBX_STATE_LENGTH1,
+  UBX_STATE_LENGTH2,
+  UBX_STATE_PAYLOAD,
+  UBX_STATE_CK_A,
+  UBX_STATE_CK_B,
+};
+
+// 8-bit Fletcher checksum over class, id, length and payload
+static inline void ubxChecksum(uint8_t& ckA, uint8_t& ckB, uint8_t byte)
+{
+  ckA += byte;
+  ckB += ckA;
+}
+
+void ubxParserInit(UbxParser* parser)
+{
+  parser->state = UBX_STATE_SYNC1;
+}
+
+bool ubxParserBusy(const UbxParser* parser)
+{
+  return parser->state != UBX_STATE_SYNC1;
+}
+
+UbxParseResult ubxParseByte(UbxParser* parser, uint8_t byte)
+{
+  switch (parser->state) {
+    case UBX_STATE_SYNC1:
+      if (byte == UBX_SYNC1) parser->state = UBX_STATE_SYNC2;
+      break;
+
+    case UBX_STATE_SYNC2:
+      if (byte == UBX_SYNC2) {
+        parser->ckA = parser->ckB = 0;
+        parser->state = UBX_STATE_CLASS;
+      } else if (byte != UBX_SYNC1) {
+        parser->state = UBX_STATE_SYNC1;
+      }
+      break;
+
+    case UBX_STATE_CLASS:
+      ubxChecksum(parser->ckA, parser->ckB, byte);
+      parser->msgClass = byte;
+      parser->state = UBX_STATE_ID;
+      break;
+
+    case UBX_STATE_ID:
+      ubxChecksum(parser->ckA, parser->ckB, byte);
+      parser->msgId = byte;
+      parser->state = UBX_STATE_LENGTH1;
+      break;
+
+    case UBX_STATE_LENGTH1:
+      ubxChecksum(parser->ckA, parser->ckB, byte);
+      parser->length = byte;
+      parser->state = UBX_STATE_LENGTH2;
+      break;
+
+    case UBX_STATE_LENGTH2:
+      ubxChecksum(parser->ckA, parser->ckB, byte);
+      parser->length |= byte << 8;
+      parser->offset = 0;
+      parser->state =
+          parser->length > 0 ? UBX_STATE_PAYLOAD : UBX_STATE_CK_A;
+      break;
+
+    case UBX_STATE_PAYLOAD:
+      ubxChecksum(parser->ckA, parser->ckB, byte);
+      // bytes beyond the buffer only count for the checksum
+      if (parser->offset < UBX_MAX_PAYLOAD)
+        parser->payload[parser->offset] = byte;
+      if (++parser->offset == parser->length)
+        parser->state = UBX_STATE_CK_A;
+      break;
+
+    case UBX_STATE_CK_A:
+      if (byte != parser->ckA) {
+        parser->state = byte == UBX_SYNC1 ? UBX_STATE_SYNC2 : UBX_STATE_SYNC1;
+        return UBX_PARSE_ERROR;
+      }
+      parser->state = UBX_STATE_CK_B;
+      break;
+
+    case UBX_STATE_CK_B:
+      parser->state = UBX_STATE_SYNC1;
+      if (byte != parser->ckB)
+        return UBX_PARSE_ERROR;
+      if (parser->length > UBX_MAX_PAYLOAD)
+        return UBX_PARSE_NONE;
+      return UBX_PARSE_FRAME;
+
+    default:
+      parser->state = UBX_STATE_SYNC1;
+      break;
+  }
+
+  return UBX_PARSE_NONE;
+}
+
+uint16_t ubxBuildFrame(uint8_t* frame, uint8_t msgClass, uint8_t msgId,
+                       const uint8_t* payload, uint16_t length)
+{
+  uint8_t* p = frame;
+  *p++ = UBX_SYNC1;
+  *p++ = UBX_SYNC2;
+  *p++ = msgClass;
+  *p++ = msgId;
+  *p++ = length & 0xFF;
+  *p++ = length >> 8;
+  for (uint16_t i = 0; i < length; i++)
+    *p++ = payload[i];
+
+  uint8_t ckA = 0, ckB = 0;
+  for (uint8_t* c = frame + 2; c < p; c++)
+    ubxChecksum(ckA, ckB, *c);
+  *p++ = ckA;
+  *p++ = ckB;
+
+  return p - frame;
+}
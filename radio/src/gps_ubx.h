@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#pragma once
+
+#include <inttypes.h>
+
+/*
+  u-blox UBX binary protocol
+
+  Frame: 0xB5 0x62 <class> <id> <length:2> <payload> <ck_a> <ck_b>
+  All values are little endian. The payload stays in the parser
+  buffer and fields are read in place with the ubxXX() helpers.
+*/
+
+#define UBX_SYNC1                 0xB5
+#define UBX_SYNC2                 0x62
+#define UBX_FRAME_OVERHEAD        8   // sync, class, id, length, checksum
+#define UBX_MAX_PAYLOAD           100 // larger frames are skipped
+
+#define UBX_CLASS_NAV             0x01
+#define UBX_CLASS_ACK             0x05
+#define UBX_CLASS_CFG             0x06
+
+#define UBX_NAV_PVT               0x07
+#define UBX_ACK_NAK               0x00
+#define UBX_ACK_ACK               0x01
+#define UBX_CFG_PRT               0x00
+#define UBX_CFG_MSG               0x01
+#define UBX_CFG_RATE              0x08
+
+// NAV-PVT payload
+#define UBX_NAV_PVT_LEN           92
+#define UBX_NAV_PVT_YEAR          4   // U2
+#define UBX_NAV_PVT_MONTH         6   // U1
+#define UBX_NAV_PVT_DAY           7   // U1
+#define UBX_NAV_PVT_HOUR          8   // U1
+#define UBX_NAV_PVT_MIN           9   // U1
+#define UBX_NAV_PVT_SEC           10  // U1
+#define UBX_NAV_PVT_VALID         11  // X1
+#define UBX_NAV_PVT_FIX_TYPE      20  // U1
+#define UBX_NAV_PVT_FLAGS         21  // X1
+#define UBX_NAV_PVT_NUM_SV        23  // U1
+#define UBX_NAV_PVT_LON           24  // I4, deg * 1e-7
+#define UBX_NAV_PVT_LAT           28  // I4, deg * 1e-7
+#define UBX_NAV_PVT_HMSL          36  // I4, mm
+#define UBX_NAV_PVT_GSPEED        60  // I4, mm/s
+#define UBX_NAV_PVT_HEAD_MOT      64  // I4, deg * 1e-5
+#define UBX_NAV_PVT_PDOP          76  // U2, * 0.01
+
+#define UBX_NAV_PVT_VALID_DATE    0x01
+#define UBX_NAV_PVT_VALID_TIME    0x02
+#define UBX_NAV_PVT_FLAGS_FIX_OK  0x01
+#define UBX_NAV_PVT_FIX_2D        2
+
+enum UbxParseResult {
+  UBX_PARSE_NONE,   // frame not complete yet, or skipped
+  UBX_PARSE_FRAME,  // a frame with a valid checksum is in the parser
+  UBX_PARSE_ERROR,  // checksum error
+};
+
+struct UbxParser {
+  uint8_t state;
+  uint8_t msgClass;
+  uint8_t msgId;
+  uint8_t ckA;
+  uint8_t ckB;
+  uint16_t length;
+  uint16_t offset;
+  uint8_t payload[UBX_MAX_PAYLOAD];
+};
+
+void ubxParserInit(UbxParser* parser);
+
+// Feed one received byte
+UbxParseResult ubxParseByte(UbxParser* parser, uint8_t byte);
+
+// True while the parser is inside a frame (from the first sync byte)
+bool ubxParserBusy(const UbxParser* parser);
+
+// Build a complete frame in 'frame' (length + UBX_FRAME_OVERHEAD bytes),
+// returns the frame size
+uint16_t ubxBuildFrame(uint8_t* frame, uint8_t msgClass, uint8_t msgId,
+                       const uint8_t* payload, uint16_t length);
+
+inline uint8_t ubxU1(const uint8_t* payload, uint16_t offset)
+{
+  return payload[offset];
+}
+
+inline uint16_t ubxU2(const uint8_t* payload, uint16_t offset)
+{
+  return payload[offset] | (payload[offset + 1] << 8);
+}
+
+inline uint32_t ubxU4(const uint8_t* payload, uint16_t offset)
+{
+  return payload[offset] | (payload[offset + 1] << 8) |
+         (payload[offset + 2] << 16) | ((uint32_t)payload[offset + 3] << 24);
+}
+
+inline int32_t ubxI4(const uint8_t* payload, uint16_t offset)
+{
+  return (int32_t)ubxU4(payload, offset);
+}
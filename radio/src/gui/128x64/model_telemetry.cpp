@@ -29,6 +29,9 @@ enum MenuModelTelemetryFrskyItems {
   ITEM_TELEMETRY_NEW_SENSOR,
   ITEM_TELEMETRY_DELETE_ALL_SENSORS,
   ITEM_TELEMETRY_IGNORE_SENSOR_INSTANCE,
+#if defined(HARDWARE_INTERNAL_MODULE)
+  ITEM_TELEMETRY_LINK_MODE,
+#endif
   ITEM_TELEMETRY_RSSI_LABEL,
   ITEM_TELEMETRY_RSSI_ALARM1,
   ITEM_TELEMETRY_RSSI_ALARM2,
@@ -66,6 +69,11 @@ uint8_t SENSOR_ROW(uint8_t value)
 #define RSSI_ROWS                     LABEL(RSSI), 0, 0, 0,
 #define SENSOR_ROWS(x)                SENSOR_ROW((isTelemetryFieldAvailable(x) ? (uint8_t)0 : HIDDEN_ROW))
 #define SENSORS_ROWS                  0, SENSOR_ROWS(0), SENSOR_ROWS(1), SENSOR_ROWS(2), SENSOR_ROWS(3), SENSOR_ROWS(4), SENSOR_ROWS(5), SENSOR_ROWS(6), SENSOR_ROWS(7), SENSOR_ROWS(8), SENSOR_ROWS(9), SENSOR_ROWS(10), SENSOR_ROWS(11), SENSOR_ROWS(12), SENSOR_ROWS(13), SENSOR_ROWS(14), SENSOR_ROWS(15), SENSOR_ROWS(16), SENSOR_ROWS(17), SENSOR_ROWS(18), SENSOR_ROWS(19), SENSOR_ROWS(20), SENSOR_ROWS(21), SENSOR_ROWS(22), SENSOR_ROWS(23), SENSOR_ROWS(24), SENSOR_ROWS(25), SENSOR_ROWS(26), SENSOR_ROWS(27), SENSOR_ROWS(28), SENSOR_ROWS(29), SENSOR_ROWS(30), SENSOR_ROWS(31), SENSOR_ROWS(32), SENSOR_ROWS(33), SENSOR_ROWS(34), SENSOR_ROWS(35), SENSOR_ROWS(36), SENSOR_ROWS(37), SENSOR_ROWS(38), SENSOR_ROWS(39), 0, 0, 0, 0,
+#if defined(HARDWARE_INTERNAL_MODULE)
+  #define LINK_MODE_ROWS              0,
+#else
+  #define LINK_MODE_ROWS
+#endif
 #if defined(VARIO)
   #define VARIO_ROWS                  LABEL(Vario), 0, 1, 2,
 #else
@@ -117,7 +125,7 @@ void onDeleteAllSensorsConfirm(const char * result)
 
 void menuModelTelemetry(event_t event)
 {
-  MENU(STR_MENUTELEMETRY, menuTabModel, MENU_MODEL_TELEMETRY, HEADER_LINE+ITEM_TELEMETRY_MAX, { HEADER_LINE_COLUMNS SENSORS_ROWS RSSI_ROWS VARIO_ROWS });
+  MENU(STR_MENUTELEMETRY, menuTabModel, MENU_MODEL_TELEMETRY, HEADER_LINE+ITEM_TELEMETRY_MAX, { HEADER_LINE_COLUMNS SENSORS_ROWS LINK_MODE_ROWS RSSI_ROWS VARIO_ROWS });
 
   uint8_t sub = menuVerticalPosition - HEADER_LINE;
 
@@ -219,6 +227,12 @@ void menuModelTelemetry(event_t event)
         g_model.ignoreSensorIds = editCheckBox(g_model.ignoreSensorIds, TELEM_COL2, y, STR_IGNORE_INSTANCE, attr, event);
         break;
 
+#if defined(HARDWARE_INTERNAL_MODULE)
+      case ITEM_TELEMETRY_LINK_MODE:
+        g_model.telemetryLinkMode = editChoice(TELEM_COL2, y, STR_TELEMETRY_LINKS, STR_VTELEMETRY_LINKS, g_model.telemetryLinkMode, TELEM_LINKS_SHARED, TELEM_LINKS_FAILOVER, attr, event);
+        break;
+#endif
+
       case ITEM_TELEMETRY_RSSI_LABEL:
         lcdDrawTextAlignedLeft(y, getRxStatLabels()->label);
         break;
@@ -23,11 +23,10 @@
 #include "libopenui_file.h"
 #include "font.h"
 
-#include <list>
-#include <string>
+#include <algorithm>
 
-#define CELL_CTRL_DIR  LV_TABLE_CELL_CTRL_CUSTOM_1
-#define CELL_CTRL_FILE LV_TABLE_CELL_CTRL_CUSTOM_2
+// directory entries read per refresh cycle
+#define FILE_BROWSER_PAGE_SIZE 32
 
 static void fb_event(lv_event_t* e)
 {
@@ -122,47 +121,22 @@ static int strnatcasecmp(char const *s1, char const *s2)
 }
 
 // natural comparison, not case sensitive.
-static bool natural_compare_nocase(const std::string & first, const std::string & second)
+static bool natural_compare_nocase(const char* first, const char* second)
 {
-  return strnatcasecmp(first.c_str(), second.c_str()) < 0;
+  return strnatcasecmp(first, second) < 0;
 }
 
-static int scan_files(std::list<std::string>& files,
-                      std::list<std::string>& directories)
+// sorts the entries added since 'from' and merges them with the others
+static void merge_sorted(std::vector<const char*>& names, size_t from)
 {
-  FILINFO fno;
-  DIR dir;
-
-  FRESULT res = f_opendir(&dir, "."); // Open the directory
-  if (res != FR_OK) return -1;
-
-  // read all entries
-  bool firstTime = true;
-  for (;;) {
-    res = sdReadDir(&dir, &fno, firstTime);
-
-    if (res != FR_OK || fno.fname[0] == 0)
-      break; // Break on error or end of dir
-    // if (strlen((const char*)fno.fname) > SD_SCREEN_FILE_LENGTH)
-    //   continue;
-    if (fno.fattrib & (AM_HID|AM_SYS)) continue;     /* Ignore hidden and system files */
-    if (fno.fname[0] == '.' && fno.fname[1] != '.') continue; // Ignore hidden files under UNIX, but not ..
-
-    if (fno.fattrib & AM_DIR) {
-      directories.push_back((char*)fno.fname);
-    } else {
-      files.push_back((char*)fno.fname);
-    }
-  }
-
-  directories.sort(natural_compare_nocase);
-  files.sort(natural_compare_nocase);
-
-  return 0;
+  if (from == names.size()) return;
+  std::sort(names.begin() + from, names.end(), natural_compare_nocase);
+  std::inplace_merge(names.begin(), names.begin() + from, names.end(),
+                     natural_compare_nocase);
 }
 
 FileBrowser::FileBrowser(Window* parent, const rect_t& rect, const char* dir) :
-    TableField(parent, rect)
+    VirtualTableField(parent, rect)
 {
   lv_obj_add_event_cb(lvobj, fb_event, LV_EVENT_ALL, nullptr);
 
@@ -176,34 +150,119 @@ FileBrowser::FileBrowser(Window* parent, const rect_t& rect, const char* dir) :
   }
 }
 
+FileBrowser::~FileBrowser()
+{
+  closeDir();
+}
+
 void FileBrowser::setFileAction(FileAction fct) { fileAction = std::move(fct); }
 void FileBrowser::setFileSelected(FileAction fct) { fileSelected = std::move(fct); }
 
 void FileBrowser::refresh()
 {
-  std::list<std::string> files;
-  std::list<std::string> directories;
-  if (scan_files(files, directories) < 0) return;
+  closeDir();
 
-  setRowCount(files.size() + directories.size());
+  directories.clear();
+  files.clear();
+  names.clear();
+  selected.clear();
 
-  uint16_t row = 0;
-  for (const auto& name: directories) {
+  if (f_opendir(&dir, ".") == FR_OK) {
+    loading = true;
+    firstTime = true;
+  }
+
+  // the first page is shown right away, the rest is read in checkEvents()
+  setItemCount(0);
+  readPage();
+  select(0, 0);
+}
 
-    // LV_SYMBOL_DIRECTORY
-    lv_table_set_cell_value(lvobj, row, 0, name.c_str());
-    lv_table_add_cell_ctrl(lvobj, row, 0, CELL_CTRL_DIR);
-    row++;
+void FileBrowser::closeDir()
+{
+  if (loading) {
+    f_closedir(&dir);
+    loading = false;
   }
+}
 
-  for (const auto& name: files) {
-    // LV_SYMBOL_FILE
-    lv_table_set_cell_value(lvobj, row, 0, name.c_str());
-    lv_table_clear_cell_ctrl(lvobj, row, 0, CELL_CTRL_DIR);
-    row++;
+void FileBrowser::readPage()
+{
+  if (!loading) return;
+
+  // keep the selection on the same entry while new ones get inserted
+  lv_table_t* table = (lv_table_t*)lvobj;
+  const char* current = nullptr;
+  bool current_is_dir = false;
+  if (table->row_act < getRowCount()) {
+    current = getRowName(table->row_act);
+    current_is_dir = isDir(table->row_act);
   }
 
-  select(0, 0);
+  size_t dirCount = directories.size();
+  size_t fileCount = files.size();
+
+  FILINFO fno;
+  for (int i = 0; i < FILE_BROWSER_PAGE_SIZE; i++) {
+    FRESULT res = sdReadDir(&dir, &fno, firstTime);
+    if (res != FR_OK || fno.fname[0] == 0) {
+      // Break on error or end of dir
+      closeDir();
+      break;
+    }
+    if (fno.fattrib & (AM_HID|AM_SYS)) continue;     /* Ignore hidden and system files */
+    if (fno.fname[0] == '.' && fno.fname[1] != '.') continue; // Ignore hidden files under UNIX, but not ..
+
+    names.emplace_back((char*)fno.fname);
+    if (fno.fattrib & AM_DIR) {
+      directories.push_back(names.back().c_str());
+    } else {
+      files.push_back(names.back().c_str());
+    }
+  }
+
+  merge_sorted(directories, dirCount);
+  merge_sorted(files, fileCount);
+
+  setItemCount(directories.size() + files.size());
+  rebind();
+
+  if (current) {
+    int row = findRow(current, current_is_dir);
+    if (row >= 0 && row != table->row_act) select(row, 0);
+  }
+}
+
+void FileBrowser::checkEvents()
+{
+  readPage();
+  VirtualTableField::checkEvents();
+}
+
+const char* FileBrowser::getRowName(uint16_t row) const
+{
+  if (isDir(row)) return directories[row];
+  return files[row - directories.size()];
+}
+
+int FileBrowser::findRow(const char* name, bool is_dir) const
+{
+  auto& list = is_dir ? directories : files;
+  auto it = std::lower_bound(list.begin(), list.end(), name,
+                             natural_compare_nocase);
+  // natural order may tie on different names (case, leading zeros)
+  for (; it != list.end() && !natural_compare_nocase(name, *it); ++it) {
+    if (*it == name) {
+      int row = it - list.begin();
+      return is_dir ? row : row + directories.size();
+    }
+  }
+  return -1;
+}
+
+void FileBrowser::bindRow(uint16_t row)
+{
+  lv_table_set_cell_value(lvobj, row, 0, getRowName(row));
 }
 
 void FileBrowser::adjustWidth()
@@ -214,14 +273,14 @@ void FileBrowser::adjustWidth()
 
 void FileBrowser::onSelected(uint16_t row, uint16_t col)
 {
-  bool is_dir = lv_table_has_cell_ctrl(lvobj, row, col, CELL_CTRL_DIR);
-  onSelected(lv_table_get_cell_value(lvobj, row, col), is_dir);
+  if (row >= getRowCount()) return;
+  onSelected(getRowName(row), isDir(row));
 }
 
 void FileBrowser::onPress(uint16_t row, uint16_t col)
 {
-  bool is_dir = lv_table_has_cell_ctrl(lvobj, row, col, CELL_CTRL_DIR);
-  onPress(lv_table_get_cell_value(lvobj, row, col), is_dir);  
+  if (row >= getRowCount()) return;
+  onPress(getRowName(row), isDir(row));
 }
 
 void FileBrowser::onDrawBegin(uint16_t row, uint16_t col, lv_obj_draw_part_dsc_t* dsc)
@@ -233,9 +292,9 @@ void FileBrowser::onDrawBegin(uint16_t row, uint16_t col, lv_obj_draw_part_dsc_t
 void FileBrowser::onDrawEnd(uint16_t row, uint16_t col, lv_obj_draw_part_dsc_t* dsc)
 {
   const char* sym = nullptr;
-  if (lv_table_has_cell_ctrl(lvobj, row, 0, CELL_CTRL_DIR)) {
+  if (isDir(row)) {
     // dir
-    const char* dir = lv_table_get_cell_value(lvobj, row, 0);
+    const char* dir = getRowName(row);
     if (dir[0] == '.')
       sym = LV_SYMBOL_LEFT;
     else
@@ -283,7 +342,7 @@ void FileBrowser::onPress(const char* name, bool is_dir)
     return;
   }
 
-  if (!selected || (selected != name)) {
+  if (selected != name) {
     onSelected(name, is_dir);
     return;
   }
@@ -21,22 +21,30 @@
 
 #pragma once
 
-#include "table.h"
+#include "virtual_table.h"
+#include "libopenui_file.h"
 
-class FileBrowser : public TableField
+#include <deque>
+#include <string>
+#include <vector>
+
+class FileBrowser : public VirtualTableField
 {
  public:
   // path, name, fullpath
   typedef std::function<void(const char*, const char*, const char*)> FileAction;
 
   FileBrowser(Window* parent, const rect_t& rect, const char* dir);
+  ~FileBrowser();
 
   void setFileAction(FileAction fct);
   void setFileSelected(FileAction fct);
   void refresh();
 
   void adjustWidth();
-  
+
+  void checkEvents() override;
+
  protected:
   void onSelected(const char* name, bool is_dir);
   void onPress(const char* name, bool is_dir);
@@ -47,8 +55,27 @@ class FileBrowser : public TableField
   void onDrawBegin(uint16_t row, uint16_t col, lv_obj_draw_part_dsc_t* dsc) override;
   void onDrawEnd(uint16_t row, uint16_t col, lv_obj_draw_part_dsc_t* dsc) override;
 
+  // VirtualTableField methods
+  void bindRow(uint16_t row) override;
+
  private:
-  const char* selected = nullptr;
+  // names never move once read, rows point into them
+  std::deque<std::string> names;
+  std::vector<const char*> directories;
+  std::vector<const char*> files;
+
+  // directory being read, a page at a time
+  DIR dir;
+  bool loading = false;
+  bool firstTime = false;
+
+  std::string selected;
   FileAction fileAction;
   FileAction fileSelected;
+
+  void readPage();
+  void closeDir();
+  bool isDir(uint16_t row) const { return row < directories.size(); }
+  const char* getRowName(uint16_t row) const;
+  int findRow(const char* name, bool is_dir) const;
 };
@@ -31,6 +31,7 @@
 #include "menu_radio.h"
 #include "menu_screen.h"
 #include "model_templates.h"
+#include "model_thumbnails.h"
 #include "opentx.h"
 #include "standalone_lua.h"
 #include "str_functions.h"
@@ -263,46 +264,55 @@ class ModelButton : public Button
 
   void load()
   {
-    const char *error = nullptr;
-
     delete buffer;
+    buffer = ModelThumbnails::create(modelCell->modelBitmap, width(), height());
+    if (buffer) return;
+
     buffer = new BitmapBuffer(BMP_RGB565, width(), height());
     if (buffer == nullptr) {
       return;
     }
     buffer->clear(COLOR_THEME_PRIMARY2);
 
-    if (error) {
-      std::string errorMsg = "(";
-      errorMsg += STR_INVALID_MODEL;
-      errorMsg += ")";
-      buffer->drawText(width() / 2, height() / 2, errorMsg.c_str(),
-                       COLOR_THEME_SECONDARY1 | CENTERED);
-    } else {
-      GET_FILENAME(filename, BITMAPS_PATH, modelCell->modelBitmap, "");
-      const BitmapBuffer *bitmap = BitmapBuffer::loadBitmap(filename);
-      if (bitmap) {
-        buffer->drawScaledBitmap(bitmap, 0, 0, width(), height());
-        delete bitmap;
-      } else {
-        std::string errorMsg = "(";
-        errorMsg += STR_NO_PICTURE;
-        errorMsg += ")";
-        buffer->drawText(width() / 2, 56, errorMsg.c_str(),
-                         FONT(XXS) | COLOR_THEME_SECONDARY1 | CENTERED);
+    std::string errorMsg = "(";
+    errorMsg += STR_NO_PICTURE;
+    errorMsg += ")";
+    buffer->drawText(width() / 2, 56, errorMsg.c_str(),
+                     FONT(XXS) | COLOR_THEME_SECONDARY1 | CENTERED);
+  }
+
+  void unload()
+  {
+    delete buffer;
+    buffer = nullptr;
+    loaded = false;
+  }
+
+  void checkEvents() override
+  {
+    Button::checkEvents();
+
+    // Thumbnails are loaded one at a time while the button is on screen,
+    // and released when it is scrolled out of view
+    if (lv_obj_is_visible(lvobj)) {
+      if (!loaded && ModelThumbnails::takeTurn()) {
+        load();
+        loaded = true;
+        invalidate();
       }
+    } else if (loaded) {
+      unload();
     }
   }
 
   void paint(BitmapBuffer *dc) override
   {
-    if (!loaded) {  // Load them on the fly
-      load();
-      loaded = true;
-    }
     FormField::paint(dc);
 
-    if (buffer) dc->drawBitmap(0, 0, buffer);
+    if (buffer)
+      dc->drawBitmap(0, 0, buffer);
+    else
+      dc->drawSolidFilledRect(0, 0, width(), height(), COLOR_THEME_PRIMARY2);
 
     if (modelCell == modelslist.getCurrentModel()) {
       dc->drawSolidFilledRect(0, 0, width(), 20, COLOR_THEME_ACTIVE);
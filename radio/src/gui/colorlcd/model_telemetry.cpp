@@ -927,6 +927,15 @@ void ModelTelemetryPage::build(FormWindow * window)
   new StaticText(line, rect_t{}, STR_IGNORE_INSTANCE, 0, COLOR_THEME_PRIMARY1);
   new ToggleSwitch(line, rect_t{}, GET_SET_DEFAULT(g_model.ignoreSensorIds));
 
+#if defined(HARDWARE_INTERNAL_MODULE)
+  // Internal / external module links
+  line = window->newLine(&grid);
+  line->padLeft(10);
+  new StaticText(line, rect_t{}, STR_TELEMETRY_LINKS, 0, COLOR_THEME_PRIMARY1);
+  new Choice(line, rect_t{}, STR_VTELEMETRY_LINKS, TELEM_LINKS_SHARED,
+             TELEM_LINKS_FAILOVER, GET_SET_DEFAULT(g_model.telemetryLinkMode));
+#endif
+
   // RX stat
   new Subtitle(window, getRxStatLabels()->label);
 
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "model_thumbnails.h"
+#include "opentx.h"
+
+#define THUMBNAILS_PATH  RADIO_PATH PATH_SEPARATOR "THUMBS"
+#define THUMBNAIL_EXT    ".thb"
+#define THUMBNAIL_MAGIC  0x31424854  // "THB1"
+
+PACK(struct ThumbnailHeader {
+  uint32_t magic;
+  uint16_t width;
+  uint16_t height;
+  uint16_t background;
+  uint16_t imageDate;
+  uint16_t imageTime;
+  uint32_t imageSize;
+});
+
+static bool getThumbnailHeader(ThumbnailHeader &header, const char *path,
+                               coord_t w, coord_t h)
+{
+  FILINFO info;
+  if (f_stat(path, &info) != FR_OK) return false;
+
+  memclear(&header, sizeof(header));
+  header.magic = THUMBNAIL_MAGIC;
+  header.width = w;
+  header.height = h;
+  header.background = COLOR_VAL(COLOR_THEME_PRIMARY2);
+  header.imageDate = info.fdate;
+  header.imageTime = info.ftime;
+  header.imageSize = info.fsize;
+  return true;
+}
+
+static void getPath(char *path, const char *dir, const char *image,
+                    const char *ext)
+{
+  char *s = strAppend(path, dir);
+  s = strAppend(s, PATH_SEPARATOR);
+  s = strAppend(s, image, LEN_BITMAP_NAME);
+  strAppend(s, ext);
+}
+
+static BitmapBuffer *loadThumbnail(const char *path,
+                                   const ThumbnailHeader &expected)
+{
+  FIL file;
+  if (f_open(&file, path, FA_OPEN_EXISTING | FA_READ) != FR_OK) return nullptr;
+
+  BitmapBuffer *thumbnail = nullptr;
+  ThumbnailHeader header;
+  UINT read;
+  if (f_read(&file, &header, sizeof(header), &read) == FR_OK &&
+      read == sizeof(header) && !memcmp(&header, &expected, sizeof(header))) {
+    thumbnail = new BitmapBuffer(BMP_RGB565, header.width, header.height);
+    if (thumbnail && thumbnail->getData() &&
+        (f_read(&file, thumbnail->getData(), thumbnail->getDataSize(), &read) !=
+             FR_OK ||
+         read != thumbnail->getDataSize())) {
+      delete thumbnail;
+      thumbnail = nullptr;
+    }
+  }
+
+  f_close(&file);
+  return thumbnail;
+}
+
+static void saveThumbnail(const char *path, const ThumbnailHeader &header,
+                          const BitmapBuffer *thumbnail)
+{
+  FIL file;
+  FRESULT result = f_open(&file, path, FA_CREATE_ALWAYS | FA_WRITE);
+  if (result == FR_NO_PATH) {
+    f_mkdir(THUMBNAILS_PATH);
+    result = f_open(&file, path, FA_CREATE_ALWAYS | FA_WRITE);
+  }
+  if (result != FR_OK) return;
+
+  UINT written;
+  bool ok = f_write(&file, &header, sizeof(header), &written) == FR_OK &&
+            written == sizeof(header) &&
+            f_write(&file, thumbnail->getData(), thumbnail->getDataSize(),
+                    &written) == FR_OK &&
+            written == thumbnail->getDataSize();
+
+  f_close(&file);
+  if (!ok) f_unlink(path);
+}
+
+namespace ModelThumbnails
+{
+
+bool takeTurn()
+{
+  static tmr10ms_t lastTurn = 0;
+  tmr10ms_t now = get_tmr10ms();
+  if (now == lastTurn) return false;
+  lastTurn = now;
+  return true;
+}
+
+BitmapBuffer *create(const char *image, coord_t w, coord_t h)
+{
+  if (!image[0]) return nullptr;
+
+  char imagePath[sizeof(BITMAPS_PATH) + LEN_BITMAP_NAME + 1];
+  getPath(imagePath, BITMAPS_PATH, image, "");
+
+  ThumbnailHeader header;
+  if (!getThumbnailHeader(header, imagePath, w, h)) return nullptr;
+
+  char thumbnailPath[sizeof(THUMBNAILS_PATH) + LEN_BITMAP_NAME +
+                     sizeof(THUMBNAIL_EXT)];
+  getPath(thumbnailPath, THUMBNAILS_PATH, image, THUMBNAIL_EXT);
+
+  BitmapBuffer *thumbnail = loadThumbnail(thumbnailPath, header);
+  if (thumbnail) return thumbnail;
+
+  BitmapBuffer *bitmap = BitmapBuffer::loadBitmap(imagePath);
+  if (!bitmap) return nullptr;
+
+  thumbnail = new BitmapBuffer(BMP_RGB565, w, h);
+  if (thumbnail && thumbnail->getData()) {
+    thumbnail->clear(COLOR_THEME_PRIMARY2);
+    thumbnail->drawScaledBitmap(bitmap, 0, 0, w, h);
+    saveThumbnail(thumbnailPath, header, thumbnail);
+  }
+  delete bitmap;
+
+  return thumbnail;
+}
+
+}  // namespace ModelThumbnails
@@ -0,0 +1,40 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+#include "libopenui.h"
+
+// Cell sized thumbnails of the model images for the model selector.
+//
+// Decoding a full size PNG or JPEG is slow, so thumbnails are built one at a
+// time between two frames (see takeTurn()), and are saved in THUMBNAILS_PATH
+// as raw RGB565. A saved thumbnail is used as long as the image file keeps
+// the same size and date.
+namespace ModelThumbnails
+{
+  // true at most once per 10ms tick, so that building thumbnails for a whole
+  // page of models does not stall the UI
+  bool takeTurn();
+
+  // returns a w x h thumbnail of the image in BITMAPS_PATH, or nullptr if it
+  // cannot be loaded
+  BitmapBuffer *create(const char *image, coord_t w, coord_t h);
+}
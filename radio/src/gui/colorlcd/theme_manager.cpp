@@ -189,7 +189,7 @@ void ThemeFile::serialize()
     yt.colors.colors[colorEntry.colorNumber-1] = colorEntry.colorValue;
   }
 
-  auto err = writeFileYaml(path.c_str(), &themeRootNode, (uint8_t*)&yt, 0);
+  auto err = writeFileYaml(path.c_str(), &themeRootNode, (uint8_t*)&yt);
   if (err != nullptr) {
     ALERT(STR_WARNING, err, AU_WARNING1);
   }
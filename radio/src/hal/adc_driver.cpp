@@ -23,6 +23,7 @@
 #include "board.h"
 
 #include "opentx.h"
+#include "tasks/mixer_task.h"
 
 const etx_hal_adc_driver_t* _hal_adc_driver = nullptr;
 const etx_hal_adc_inputs_t* _hal_adc_inputs = nullptr;
@@ -57,9 +58,57 @@ static bool adcSingleRead()
   return true;
 }
 
+static bool _adc_started = false;
+static bool _adc_vbat_started = false;
+static bool _adc_valid = false;
+
+// Wait for the conversion running in the background, if any
+static void adcWaitBackground()
+{
+  if (!_adc_started)
+    return;
+
+  if (_hal_adc_driver->wait_completion) {
+    _hal_adc_driver->wait_completion();
+  } else {
+    while (!_hal_adc_driver->check_completion());
+  }
+  _adc_started = false;
+}
+
+static bool adcBackgroundRead()
+{
+  if (_adc_started) {
+    // still converting: keep the values of the last conversion
+    if (!_hal_adc_driver->check_completion())
+      return true;
+    _adc_started = false;
+  }
+
+  // the VBAT bridge is only needed for one complete conversion
+  if (_adc_vbat_started && isVBatBridgeEnabled()) {
+    disableVBatBridge();
+  }
+
+  _adc_vbat_started = isVBatBridgeEnabled();
+  _adc_started = !_hal_adc_driver->start_conversion ||
+                 _hal_adc_driver->start_conversion();
+
+  return true;
+}
+
 bool adcRead()
 {
-  adcSingleRead();
+  // Background conversions only pay off in the mixer loop, once a first
+  // conversion is complete. One-shot reads (boot, throttle and RTC battery
+  // checks) must not see stale or empty values.
+  if (_hal_adc_driver && _hal_adc_driver->check_completion &&
+      _adc_valid && mixerTaskRunning())
+    return adcBackgroundRead();
+
+  adcWaitBackground();
+  _adc_vbat_started = false;
+  _adc_valid = adcSingleRead();
   
   // TODO: this hack needs to go away...
   if (isVBatBridgeEnabled()) {
@@ -257,6 +306,34 @@ uint16_t* getAnalogValues()
   return adcValues;
 }
 
+static volatile uint32_t _adc_values_seq = 0;
+
+void adcValuesWriteBegin()
+{
+  _adc_values_seq = _adc_values_seq + 1;
+  __sync_synchronize();
+}
+
+void adcValuesWriteEnd()
+{
+  __sync_synchronize();
+  _adc_values_seq = _adc_values_seq + 1;
+}
+
+void adcGetValues(uint16_t* values)
+{
+  // Writers are interrupts: a few retries are enough. Giving up after that
+  // only means a mix of two consecutive conversions, never a wait.
+  for (uint8_t retry = 0; retry < 4; retry++) {
+    uint32_t seq = _adc_values_seq;
+    __sync_synchronize();
+    memcpy(values, adcValues, sizeof(adcValues));
+    __sync_synchronize();
+    if (!(seq & 1) && seq == _adc_values_seq)
+      break;
+  }
+}
+
 // used by diaganas
 uint32_t s_anaFilt[MAX_ANALOG_INPUTS];
 
@@ -447,13 +524,16 @@ void getADC()
   if (!adcRead()) TRACE("adcRead failed");
   DEBUG_TIMER_STOP(debugTimerAdcRead);
 
+  uint16_t values[MAX_ANALOG_INPUTS];
+  adcGetValues(values);
+
   for (uint8_t x = 0; x < max_analogs; x++) {
 
     bool is_flex_input = (x >= pot_offset) && (x < pot_offset + max_pots);
     bool is_multipos = is_flex_input && IS_POT_MULTIPOS(x - pot_offset);
 
     // 1st: apply calibration
-    uint32_t v = getAnalogValue(x);
+    uint32_t v = values[x];
 
     if (x < max_calib_analogs && !is_multipos) {
       v = apply_calibration(&g_eeGeneral.calib[x], v);
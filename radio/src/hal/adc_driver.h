@@ -77,6 +77,12 @@ struct etx_hal_adc_driver_t {
   bool (*init)();
   bool (*start_conversion)();
   void (*wait_completion)();
+
+  // Optional: returns true once the last started conversion has completed.
+  // When provided, adcRead() does not wait in the mixer loop: it keeps the
+  // values of the last completed conversion and starts the next one in the
+  // background. Other reads still wait for a fresh conversion.
+  bool (*check_completion)();
 };
 
 bool adcInit(const etx_hal_adc_driver_t* driver);
@@ -89,6 +95,12 @@ uint16_t getAnalogValue(uint8_t index);
 void setAnalogValue(uint8_t index, uint16_t value);
 uint16_t* getAnalogValues();
 
+// Drivers updating the analog values from an interrupt wrap the update with
+// these, so that adcGetValues() always returns a complete set (seqlock).
+void adcValuesWriteBegin();
+void adcValuesWriteEnd();
+void adcGetValues(uint16_t* values);
+
 // Run calibration steps:
 
 // Set default values before loading radio settings
@@ -108,9 +120,13 @@ extern JitterMeter<uint16_t> rawJitter[MAX_ANALOG_INPUTS];
 extern JitterMeter<uint16_t> avgJitter[MAX_ANALOG_INPUTS];
 #endif
 
+// filtered analog values, used by diaganas and saved with the mixer state
+extern uint32_t s_anaFilt[];
+
 void getADC();
 uint16_t anaIn(uint8_t chan);
 uint32_t anaIn_diag(uint8_t chan);
+void anaSetFiltered(uint8_t chan, uint16_t val);
 uint16_t getBatteryVoltage();
 
 // Warning:
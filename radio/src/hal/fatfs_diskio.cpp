@@ -91,6 +91,29 @@ uint8_t fatfsGetLun(uint8_t pdrv)
   return _fatfs_drives[pdrv].lun;
 }
 
+void fatfsIdle()
+{
+  for (uint8_t i = 0; i < _fatfs_n_drives; i++) {
+    auto& drive = _fatfs_drives[i];
+    if (!drive.initialized || !drive.drv->idle) {
+      continue;
+    }
+
+#if FF_FS_REENTRANT != 0
+    // never wait for FatFs, try again next time
+    if (!RTOS_TRYLOCK_MUTEX(drive.mutex)) {
+      continue;
+    }
+#endif
+
+    drive.drv->idle(drive.lun);
+
+#if FF_FS_REENTRANT != 0
+    RTOS_UNLOCK_MUTEX(drive.mutex);
+#endif
+  }
+}
+
 #if FF_FS_REENTRANT != 0
 
 int ff_cre_syncobj(BYTE vol, FF_SYNC_t* mutex)
@@ -37,6 +37,9 @@ struct diskio_driver_t
   DRESULT (*write)(BYTE pdrv, const BYTE* buff, DWORD sector, UINT count);
 
   DRESULT (*ioctl)(BYTE pdrv, BYTE cmd, void* buff);
+
+  // optional background maintenance, called with the volume locked
+  void (*idle)(BYTE pdrv);
 };
 
 // returns 1 if successful, 0 otherwise
@@ -50,3 +53,6 @@ const diskio_driver_t* fatfsGetDriver(uint8_t pdrv);
 
 // returns a physical LUN or 0
 uint8_t fatfsGetLun(uint8_t pdrv);
+
+// run the drivers' background maintenance on volumes not in use
+void fatfsIdle();
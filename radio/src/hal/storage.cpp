@@ -23,6 +23,7 @@
 #include "hal.h"
 
 #include "debug.h"
+#include "usb_driver.h"
 
 #if defined(STORAGE_USE_SDIO)
   #include "diskio_sdio.h"
@@ -45,6 +46,7 @@
     .read = disk_cache_read,
     .write = disk_cache_write,
     .ioctl = _STORAGE_DRIVER.ioctl,
+    .idle = _STORAGE_DRIVER.idle,
   };
 #endif
 
@@ -77,6 +79,16 @@ void storagePreMountHook()
 #endif
 }
 
+void storageIdle()
+{
+  // In mass storage mode the USB interrupt reads and writes the volume
+  // without taking the FatFs lock, maintenance would race with it
+  if (usbStarted() && getSelectedUsbMode() == USB_MASS_STORAGE_MODE)
+    return;
+
+  fatfsIdle();
+}
+
 bool storageIsPresent()
 {
   return (_STORAGE_DRIVER.status(0) & STA_NODISK) == 0;
@@ -31,6 +31,11 @@ void storageDeInit();
 // Called before the storage is mounted
 void storagePreMountHook();
 
+// Called periodically from a low priority task
+// to run background maintenance (e.g. FTL garbage collection).
+// Does nothing while the volume is exported as USB mass storage.
+void storageIdle();
+
 bool storageIsPresent();
 
 #define SD_CARD_PRESENT() storageIsPresent()
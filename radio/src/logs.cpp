@@ -35,6 +35,15 @@ FIL g_oLogFile __DMA;
 uint8_t logDelay100ms;
 static tmr10ms_t lastLogTime = 0;
 
+// Log lines are gathered in a RAM buffer and written to the card by whole
+// sectors, in file space reserved by large chunks of clusters, so that FatFs
+// neither extends the cluster chain nor rewrites a partial sector on each line
+#define LOGS_BUFFER_SIZE    (2 * FF_MAX_SS)
+
+static char logsBuffer[LOGS_BUFFER_SIZE] __DMA;
+static UINT logsBufferCount = 0;
+static FSIZE_t logsAllocated = 0;  // end of the space reserved for the file
+
 #if !defined(SIMU)
 #include <FreeRTOS/include/FreeRTOS.h>
 #include <FreeRTOS/include/timers.h>
@@ -102,6 +111,85 @@ void initLoggingTimer() {                                       // called cyclic
 
 void writeHeader();
 
+// Reserve file space for at least len more bytes
+static void logsReserve(UINT len)
+{
+  FSIZE_t pos = f_tell(&g_oLogFile);
+  if (pos + len <= logsAllocated)
+    return;
+
+  // seeking past the end of a file opened for writing stretches its
+  // cluster chain in one go, the real size is set by f_truncate() on close
+  logsAllocated = pos + len + LOGS_PREALLOC_SIZE;
+  if (f_lseek(&g_oLogFile, logsAllocated) != FR_OK ||
+      f_tell(&g_oLogFile) < logsAllocated) {
+    // card full, clusters will be allocated while writing
+    logsAllocated = 0;
+  }
+  f_lseek(&g_oLogFile, pos);
+}
+
+// Write the buffered data, up to the last sector boundary unless all is set
+static FRESULT logsFlush(bool all)
+{
+  UINT len = logsBufferCount;
+  if (!all) {
+    len -= (f_tell(&g_oLogFile) + logsBufferCount) % FF_MAX_SS;
+    if (len > logsBufferCount)
+      len = 0;  // less than the remainder of the current sector
+  }
+
+  if (len == 0)
+    return FR_OK;
+
+  logsReserve(len);
+
+  UINT written;
+  FRESULT result = f_write(&g_oLogFile, logsBuffer, len, &written);
+  if (result == FR_OK && written != len)
+    result = FR_DENIED;
+
+  logsBufferCount -= len;
+  memmove(logsBuffer, logsBuffer + len, logsBufferCount);
+  return result;
+}
+
+static void logsPut(const char * data, UINT len)
+{
+  while (len > 0) {
+    if (logsBufferCount == LOGS_BUFFER_SIZE) {
+      logsFlush(false);
+    }
+    UINT count = min<UINT>(len, LOGS_BUFFER_SIZE - logsBufferCount);
+    memcpy(logsBuffer + logsBufferCount, data, count);
+    logsBufferCount += count;
+    data += count;
+    len -= count;
+  }
+}
+
+static void logsPuts(const char * str)
+{
+  logsPut(str, strlen(str));
+}
+
+static void logsPutc(char c)
+{
+  logsPut(&c, 1);
+}
+
+static void logsPrintf(const char * format, ...)
+{
+  char tmp[64];
+  va_list arglist;
+  va_start(arglist, format);
+  int len = vsnprintf(tmp, sizeof(tmp), format, arglist);
+  va_end(arglist);
+  if (len > 0) {
+    logsPut(tmp, min<UINT>(len, sizeof(tmp) - 1));
+  }
+}
+
 int getSwitchState(uint8_t swtch) {
   int value = getValue(MIXSRC_FIRST_SWITCH + swtch);
   return (value == 0) ? 0 : (value < 0) ? -1 : +1;
@@ -172,7 +260,14 @@ const char * logsOpen()
     return SDCARD_ERROR(result);
   }
 
-  if (f_size(&g_oLogFile) == 0) {
+  logsBufferCount = 0;
+  logsAllocated = f_size(&g_oLogFile);
+
+  if (logsAllocated == 0) {
+    // a new file gets a first chunk of contiguous clusters
+    if (f_expand(&g_oLogFile, LOGS_PREALLOC_SIZE, 1) == FR_OK) {
+      logsAllocated = LOGS_PREALLOC_SIZE;
+    }
     writeHeader();
   }
 
@@ -182,6 +277,9 @@ const char * logsOpen()
 void logsClose()
 {
   if (g_oLogFile.obj.fs && sdMounted()) {
+    logsFlush(true);
+    // release the space reserved after the last line
+    f_truncate(&g_oLogFile);
     if (f_close(&g_oLogFile) != FR_OK) {
       // close failed, forget file
       g_oLogFile.obj.fs = 0;
@@ -194,9 +292,9 @@ void logsClose()
 void writeHeader()
 {
 #if defined(RTCLOCK)
-  f_puts("Date,Time,", &g_oLogFile);
+  logsPuts("Date,Time,");
 #else
-  f_puts("Time,", &g_oLogFile);
+  logsPuts("Time,");
 #endif
 
 
@@ -215,7 +313,7 @@ void writeHeader()
           strcat(label, ")");
         }
         strcat(label, ",");
-        f_puts(label, &g_oLogFile);
+        logsPuts(label);
       }
     }
   }
@@ -223,16 +321,16 @@ void writeHeader()
   auto n_inputs = adcGetMaxInputs(ADC_INPUT_MAIN);
   for (uint8_t i = 0; i < n_inputs; i++) {
     const char* p = analogGetCanonicalName(ADC_INPUT_MAIN, i);
-    while (*p) { f_putc(*(p++), &g_oLogFile); }
-    f_putc(',', &g_oLogFile);
+    while (*p) { logsPutc(*(p++)); }
+    logsPutc(',');
   }
 
   n_inputs = adcGetMaxInputs(ADC_INPUT_FLEX);
   for (uint8_t i = 0; i < n_inputs; i++) {
     if (!IS_POT_AVAILABLE(i)) continue;
     const char* p = analogGetCanonicalName(ADC_INPUT_FLEX, i);
-    while (*p) { f_putc(*(p++), &g_oLogFile); }
-    f_putc(',', &g_oLogFile);
+    while (*p) { logsPutc(*(p++)); }
+    logsPutc(',');
   }
 
   for (uint8_t i = 0; i < switchGetMaxSwitches(); i++) {
@@ -242,16 +340,16 @@ void writeHeader()
       temp = getSwitchName(s, i);
       *temp++ = ',';
       *temp = '\0';
-      f_puts(s, &g_oLogFile);
+      logsPuts(s);
     }
   }
-  f_puts("LSW,", &g_oLogFile);
+  logsPuts("LSW,");
   
   for (uint8_t channel = 0; channel < MAX_OUTPUT_CHANNELS; channel++) {
-    f_printf(&g_oLogFile, "CH%d(us),", channel+1);
+    logsPrintf("CH%d(us),", channel+1);
   }
 
-  f_puts("TxBat(V)\n", &g_oLogFile);
+  logsPuts("TxBat(V)\n");
 }
 
 uint32_t getLogicalSwitchesStates(uint8_t first)
@@ -313,10 +411,10 @@ void logsWrite()
           lastRtcTime = g_rtcTime;
           gettime(&utm);
         }
-        f_printf(&g_oLogFile, "%4d-%02d-%02d,%02d:%02d:%02d.%02d0,", utm.tm_year+TM_YEAR_BASE, utm.tm_mon+1, utm.tm_mday, utm.tm_hour, utm.tm_min, utm.tm_sec, g_ms100);
+        logsPrintf("%4d-%02d-%02d,%02d:%02d:%02d.%02d0,", utm.tm_year+TM_YEAR_BASE, utm.tm_mon+1, utm.tm_mday, utm.tm_hour, utm.tm_min, utm.tm_sec, g_ms100);
       }
 #else
-      f_printf(&g_oLogFile, "%d,", tmr10ms);
+      logsPrintf("%d,", tmr10ms);
 #endif
 
       for (int i=0; i<MAX_TELEMETRY_SENSORS; i++) {
@@ -327,34 +425,34 @@ void logsWrite()
             if (sensor.unit == UNIT_GPS) {
               if (telemetryItem.gps.longitude && telemetryItem.gps.latitude) {
                 div_t qr = div((int)telemetryItem.gps.latitude, 1000000);
-                if (telemetryItem.gps.latitude < 0) f_printf(&g_oLogFile, "-");
-                f_printf(&g_oLogFile, "%d.%06d ", abs(qr.quot), abs(qr.rem));
+                if (telemetryItem.gps.latitude < 0) logsPrintf("-");
+                logsPrintf("%d.%06d ", abs(qr.quot), abs(qr.rem));
                 qr = div((int)telemetryItem.gps.longitude, 1000000);
-                if (telemetryItem.gps.longitude < 0) f_printf(&g_oLogFile, "-");
-                f_printf(&g_oLogFile, "%d.%06d,", abs(qr.quot), abs(qr.rem));
+                if (telemetryItem.gps.longitude < 0) logsPrintf("-");
+                logsPrintf("%d.%06d,", abs(qr.quot), abs(qr.rem));
               }
               else {
-                f_printf(&g_oLogFile, ",");
+                logsPrintf(",");
               }
             }
             else if (sensor.unit == UNIT_DATETIME) {
-              f_printf(&g_oLogFile, "%4d-%02d-%02d %02d:%02d:%02d,", telemetryItem.datetime.year, telemetryItem.datetime.month, telemetryItem.datetime.day, telemetryItem.datetime.hour, telemetryItem.datetime.min, telemetryItem.datetime.sec);
+              logsPrintf("%4d-%02d-%02d %02d:%02d:%02d,", telemetryItem.datetime.year, telemetryItem.datetime.month, telemetryItem.datetime.day, telemetryItem.datetime.hour, telemetryItem.datetime.min, telemetryItem.datetime.sec);
             }
             else if (sensor.unit == UNIT_TEXT) {
-              f_printf(&g_oLogFile, "\"%s\",", telemetryItem.text);
+              logsPrintf("\"%s\",", telemetryItem.text);
             }
             else if (sensor.prec == 2) {
               div_t qr = div((int)telemetryItem.value, 100);
-              if (telemetryItem.value < 0) f_printf(&g_oLogFile, "-");
-              f_printf(&g_oLogFile, "%d.%02d,", abs(qr.quot), abs(qr.rem));
+              if (telemetryItem.value < 0) logsPrintf("-");
+              logsPrintf("%d.%02d,", abs(qr.quot), abs(qr.rem));
             }
             else if (sensor.prec == 1) {
               div_t qr = div((int)telemetryItem.value, 10);
-              if (telemetryItem.value < 0) f_printf(&g_oLogFile, "-");
-              f_printf(&g_oLogFile, "%d.%d,", abs(qr.quot), abs(qr.rem));
+              if (telemetryItem.value < 0) logsPrintf("-");
+              logsPrintf("%d.%d,", abs(qr.quot), abs(qr.rem));
             }
             else {
-              f_printf(&g_oLogFile, "%d,", telemetryItem.value);
+              logsPrintf("%d,", telemetryItem.value);
             }
           }
         }
@@ -364,7 +462,7 @@ void logsWrite()
       auto offset = adcGetInputOffset(ADC_INPUT_MAIN);
 
       for (uint8_t i = 0; i < n_inputs; i++) {
-        f_printf(&g_oLogFile, "%d,", calibratedAnalogs[inputMappingConvertMode(offset + i)]);
+        logsPrintf("%d,", calibratedAnalogs[inputMappingConvertMode(offset + i)]);
       }
 
       n_inputs = adcGetMaxInputs(ADC_INPUT_FLEX);
@@ -372,25 +470,26 @@ void logsWrite()
 
       for (uint8_t i = 0; i < n_inputs; i++) {
         if (IS_POT_AVAILABLE(i))
-          f_printf(&g_oLogFile, "%d,", calibratedAnalogs[offset + i]);
+          logsPrintf("%d,", calibratedAnalogs[offset + i]);
       }
 
       for (uint8_t i = 0; i < switchGetMaxSwitches(); i++) {
         if (SWITCH_EXISTS(i)) {
-          f_printf(&g_oLogFile, "%d,", getSwitchState(i));
+          logsPrintf("%d,", getSwitchState(i));
         }
       }
-      f_printf(&g_oLogFile, "0x%08X%08X,", getLogicalSwitchesStates(32),
+      logsPrintf("0x%08X%08X,", getLogicalSwitchesStates(32),
                getLogicalSwitchesStates(0));
 
       for (uint8_t channel = 0; channel < MAX_OUTPUT_CHANNELS; channel++) {
-        f_printf(&g_oLogFile, "%d,", PPM_CENTER+channelOutputs[channel]/2); // in us
+        logsPrintf("%d,", PPM_CENTER+channelOutputs[channel]/2); // in us
       }
 
       div_t qr = div(g_vbat100mV, 10);
-      int result = f_printf(&g_oLogFile, "%d.%d\n", abs(qr.quot), abs(qr.rem));
+      logsPrintf("%d.%d\n", abs(qr.quot), abs(qr.rem));
 
-      if (result<0 && !error_displayed) {
+      FRESULT result = logsFlush(false);
+      if (result != FR_OK && !error_displayed) {
         error_displayed = STR_SDCARD_ERROR;
         POPUP_WARNING_ON_UI_TASK(STR_SDCARD_ERROR, nullptr, false);
         logsClose();
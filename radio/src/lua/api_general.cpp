@@ -44,6 +44,7 @@
 #endif
 
 #include "telemetry/frsky.h"
+#include "telemetry/telemetry_history.h"
 
 #if defined(MULTIMODULE)
   #include "telemetry/multi.h"
@@ -103,7 +104,7 @@ void luaFreeRxFifo()
 void luaReceiveData(uint8_t* buf, uint32_t len)
 {
   if (luaRxFifo) {
-    while(len--) luaRxFifo->push(*buf++);
+    luaRxFifo->write(buf, len);
   }
 }
 
@@ -927,9 +928,7 @@ static int luaSportTelemetryPop(lua_State * L)
 
   if (luaInputTelemetryFifo->size() >= sizeof(SportTelemetryPacket)) {
     SportTelemetryPacket packet;
-    for (uint8_t i=0; i<sizeof(packet); i++) {
-      luaInputTelemetryFifo->pop(packet.raw[i]);
-    }
+    luaInputTelemetryFifo->read(packet.raw, sizeof(packet));
     lua_pushnumber(L, packet.physicalId);
     lua_pushnumber(L, packet.primId);
     lua_pushnumber(L, packet.dataId);
@@ -1986,6 +1985,118 @@ static int luaSetTelemetryValue(lua_State * L)
   return 1;
 }
 
+/*luadoc
+@function setSensorHistory(sensor, depth [, period])
+
+Record the values of a telemetry sensor in a history kept by the firmware,
+to be read with getSensorHistory(). This avoids sampling getValue() and
+storing the values in Lua tables.
+
+@param sensor (number) sensor index, from 0 (see model.getSensor())
+
+@param depth (number) number of samples kept, limited to 480 on color
+screen radios and 128 on the others. `0` stops recording
+
+@param period (number) sampling period in 10ms units, default is 10 (100ms)
+
+@retval true if the history is recorded, false otherwise (all history slots
+are used: 8 on color screen radios, 4 on the others)
+
+@notice The history of all sensors is stopped when another model is loaded
+
+@status current Introduced in 2.10
+*/
+static int luaSetSensorHistory(lua_State * L)
+{
+  int sensor = luaL_checkinteger(L, 1);
+  int depth = luaL_checkinteger(L, 2);
+  int period = luaL_optinteger(L, 3, TELEMETRY_HISTORY_DEFAULT_PERIOD);
+
+  if (sensor < 0 || sensor >= MAX_TELEMETRY_SENSORS) {
+    lua_pushboolean(L, false);
+    return 1;
+  }
+
+  lua_pushboolean(L, telemetryHistory.start(sensor, limit(0, depth, TELEMETRY_HISTORY_DEPTH),
+                                            limit(1, period, 255)));
+  return 1;
+}
+
+static void luaPushSensorSample(lua_State * L, const TelemetrySensor & sensor, int32_t value)
+{
+  if (sensor.prec > 0)
+    lua_pushnumber(L, float(value) / sensor.getPrecDivisor());
+  else
+    lua_pushinteger(L, value);
+}
+
+/*luadoc
+@function getSensorHistory(sensor [, count [, points]])
+
+Return the history of a telemetry sensor started with setSensorHistory()
+
+@param sensor (number) sensor index, from 0
+
+@param count (number) number of the most recent samples returned, default is all of them
+
+@param points (number) when given and lower than count, the samples are split in
+`points` groups and the minimum and maximum of each group are returned instead,
+e.g. one group per pixel of a chart
+
+@retval values (table) the samples, from the oldest to the most recent one,
+with the precision of the sensor. The last value is repeated while the sensor
+is silent
+
+@retval mins, maxs (tables) when `points` is used, the minimum and maximum of each group
+
+@retval nil the sensor has no history
+
+@status current Introduced in 2.10
+*/
+static int luaGetSensorHistory(lua_State * L)
+{
+  int sensor = luaL_checkinteger(L, 1);
+  if (sensor < 0 || sensor >= MAX_TELEMETRY_SENSORS) {
+    lua_pushnil(L);
+    return 1;
+  }
+
+  int count = limit(0, (int)luaL_optinteger(L, 2, TELEMETRY_HISTORY_DEPTH), TELEMETRY_HISTORY_DEPTH);
+  int points = limit(0, (int)luaL_optinteger(L, 3, 0), count);
+  bool groups = (points > 0 && points < count);
+
+  // copied in one pass, the tables are built once the history is released
+  int32_t * values = (int32_t *)lua_newuserdata(L, (groups ? 2 * points : count) * sizeof(int32_t));
+
+  // keep the chart scrolling while the sensor is silent
+  count = telemetryHistory.read(sensor, get_tmr10ms(), count, points, values);
+  if (count < 0) {
+    lua_pushnil(L);
+    return 1;
+  }
+
+  const TelemetrySensor & telemetrySensor = g_model.telemetrySensors[sensor];
+
+  if (points == 0 || points >= count) {
+    lua_createtable(L, count, 0);
+    for (int i = 0; i < count; i++) {
+      luaPushSensorSample(L, telemetrySensor, values[i]);
+      lua_rawseti(L, -2, i + 1);
+    }
+    return 1;
+  }
+
+  lua_createtable(L, points, 0);
+  lua_createtable(L, points, 0);
+  for (int i = 0; i < points; i++) {
+    luaPushSensorSample(L, telemetrySensor, values[2 * i]);
+    lua_rawseti(L, -3, i + 1);
+    luaPushSensorSample(L, telemetrySensor, values[2 * i + 1]);
+    lua_rawseti(L, -2, i + 1);
+  }
+  return 2;
+}
+
 /*luadoc
 @function defaultChannel(stick)
 
@@ -2950,6 +3061,8 @@ LROT_BEGIN(etxlib, NULL, 0)
   LROT_FUNCENTRY( sportTelemetryPop, luaSportTelemetryPop )
   LROT_FUNCENTRY( sportTelemetryPush, luaSportTelemetryPush )
   LROT_FUNCENTRY( setTelemetryValue, luaSetTelemetryValue )
+  LROT_FUNCENTRY( setSensorHistory, luaSetSensorHistory )
+  LROT_FUNCENTRY( getSensorHistory, luaGetSensorHistory )
 #if defined(CROSSFIRE)
   LROT_FUNCENTRY( crossfireTelemetryPop, luaCrossfireTelemetryPop )
   LROT_FUNCENTRY( crossfireTelemetryPush, luaCrossfireTelemetryPush )
@@ -28,6 +28,7 @@
 #include "hal/adc_driver.h"
 #include "hal/trainer_driver.h"
 #include "hal/switch_driver.h"
+#include "tasks/mixer_task.h"
 
 uint8_t s_mixer_first_run_done = false;
 
@@ -152,6 +153,24 @@ int expo(int x, int k)
   return neg ? -y : y;
 }
 
+// Sources of the expo and mix lines, resolved again only when the line
+// source changes
+static uint32_t expoSources[MAX_EXPOS];
+static uint32_t mixSources[MAX_MIXERS];
+
+// Each cache entry packs the source with its SourceRef in one word, so that
+// the UI and mixer tasks never see a torn entry
+getvalue_t getCachedSourceValue(uint32_t & cache, mixsrc_t source)
+{
+  uint32_t entry = cache;
+  if ((entry & 0xFFFF) != source) {
+    SourceRef src = resolveSource(source);
+    entry = source | ((uint32_t)src.kind << 16) | ((uint32_t)src.index << 24);
+    cache = entry;
+  }
+  return getSourceValue({(uint8_t)(entry >> 16), (uint8_t)(entry >> 24)});
+}
+
 void applyExpos(int16_t * anas, uint8_t mode, uint8_t ovwrIdx, int16_t ovwrValue)
 {
   int8_t cur_chn = -1;
@@ -172,7 +191,7 @@ void applyExpos(int16_t * anas, uint8_t mode, uint8_t ovwrIdx, int16_t ovwrValue
         v = ovwrValue;
       }
       else {
-        v = getValue(ed->srcRaw);
+        v = getCachedSourceValue(expoSources[i], ed->srcRaw);
         if (ed->srcRaw >= MIXSRC_FIRST_TELEM && ed->scale > 0) {
           v = (v * 1024) / convertTelemValue(ed->srcRaw-MIXSRC_FIRST_TELEM+1, ed->scale);
         }
@@ -308,162 +327,241 @@ static const getvalue_t _switch_3pos_lookup[] = {
   +1024, // SWITCH_HW_DOWN 
 };
 
-// TODO same naming convention than the drawSource
-// *valid added to return status to Lua for invalid sources
-getvalue_t getValue(mixsrc_t i, bool* valid)
+SourceRef resolveSource(mixsrc_t i)
 {
   if (i == MIXSRC_NONE) {
-    if (valid != nullptr) *valid = false;
-    return 0;
+    return {SOURCE_KIND_NONE, 0};
   }
   else if (i <= MIXSRC_LAST_INPUT) {
-    return anas[i - MIXSRC_FIRST_INPUT];
+    return {SOURCE_KIND_INPUT, (uint8_t)(i - MIXSRC_FIRST_INPUT)};
   }
 #if defined(LUA_INPUTS)
   else if (i <= MIXSRC_LAST_LUA) {
 #if defined(LUA_MODEL_SCRIPTS)
-    div_t qr = div(i-MIXSRC_FIRST_LUA, MAX_SCRIPT_OUTPUTS);
-    return scriptInputsOutputs[qr.quot].outputs[qr.rem].value;
+    return {SOURCE_KIND_LUA, (uint8_t)(i - MIXSRC_FIRST_LUA)};
 #else
-    if (valid != nullptr) *valid = false;
-    return 0;
+    return {SOURCE_KIND_NONE, 0};
 #endif
   }
 #endif
 
   else if (i <= MIXSRC_LAST_STICK) {
     i -= MIXSRC_FIRST_STICK;
-    if (i >= adcGetMaxInputs(ADC_INPUT_MAIN)) {
-      if (valid != nullptr) *valid = false;
-      return 0;
-    }
-    return calibratedAnalogs[inputMappingConvertMode(i)];
+    if (i >= adcGetMaxInputs(ADC_INPUT_MAIN))
+      return {SOURCE_KIND_NONE, 0};
+    return {SOURCE_KIND_STICK, (uint8_t)i};
   }
   else if (i <= MIXSRC_LAST_POT) {
     i -= MIXSRC_FIRST_POT;
-    if (i >= adcGetMaxInputs(ADC_INPUT_FLEX)) {
-      if (valid != nullptr) *valid = false;
-      return 0;
-    }
-    return calibratedAnalogs[i + adcGetInputOffset(ADC_INPUT_FLEX)];
+    if (i >= adcGetMaxInputs(ADC_INPUT_FLEX))
+      return {SOURCE_KIND_NONE, 0};
+    return {SOURCE_KIND_ANALOG, (uint8_t)(i + adcGetInputOffset(ADC_INPUT_FLEX))};
   }
 
 #if defined(IMU)
   else if (i == MIXSRC_TILT_X) {
-    return gyro.scaledX();
+    return {SOURCE_KIND_TILT_X, 0};
   }
   else if (i == MIXSRC_TILT_Y) {
-    return gyro.scaledY();
+    return {SOURCE_KIND_TILT_Y, 0};
   }
 #endif
 
 #if defined(SPACEMOUSE)
   else if (i >= MIXSRC_FIRST_SPACEMOUSE && i <= MIXSRC_LAST_SPACEMOUSE) {
-    return get_spacemouse_value(i - MIXSRC_FIRST_SPACEMOUSE);
+    return {SOURCE_KIND_SPACEMOUSE, (uint8_t)(i - MIXSRC_FIRST_SPACEMOUSE)};
   }
 #endif
 
   else if (i == MIXSRC_MIN) {
-    return -RESX;
+    return {SOURCE_KIND_MIN, 0};
   }
   else if (i == MIXSRC_MAX) {
-    return RESX;
+    return {SOURCE_KIND_MAX, 0};
   }
 
   else if (i <= MIXSRC_LAST_HELI) {
 #if defined(HELI)
-    return cyc_anas[i - MIXSRC_FIRST_HELI];
+    return {SOURCE_KIND_HELI, (uint8_t)(i - MIXSRC_FIRST_HELI)};
 #else
-    if (valid != nullptr) *valid = false;
-    return 0;
+    return {SOURCE_KIND_NONE, 0};
 #endif
   }
 
   else if (i <= MIXSRC_LAST_TRIM) {
-    i -= MIXSRC_FIRST_TRIM;
-    auto trim_value = getTrimValue(mixerCurrentFlightMode, i);
-    return calc1000toRESX((int16_t)8 * trim_value);
+    return {SOURCE_KIND_TRIM, (uint8_t)(i - MIXSRC_FIRST_TRIM)};
   }
   else if (i >= MIXSRC_FIRST_SWITCH && i <= MIXSRC_LAST_SWITCH) {
-    auto sw_idx = (uint8_t)(i - MIXSRC_FIRST_SWITCH);
-#if defined(FUNCTION_SWITCHES)
-    auto max_reg_switches = switchGetMaxSwitches();
-    if (sw_idx >= max_reg_switches) {
-      auto fct_idx = sw_idx - max_reg_switches;
-      auto max_fct_switches = switchGetMaxFctSwitches();
-      if (fct_idx < max_fct_switches) {
-	return _switch_2pos_lookup[getFSLogicalState(fct_idx)];
-      }
-    }
-#endif
-    auto sw_cfg = (SwitchConfig)SWITCH_CONFIG(sw_idx);
-    switch(sw_cfg) {
-    case SWITCH_NONE:
-      if (valid != nullptr) *valid = false;
-      return 0;
-    case SWITCH_TOGGLE:
-    case SWITCH_2POS:
-      return _switch_2pos_lookup[switchGetPosition(sw_idx)];
-    case SWITCH_3POS:
-      return _switch_3pos_lookup[switchGetPosition(sw_idx)];
-    }
+    return {SOURCE_KIND_SWITCH, (uint8_t)(i - MIXSRC_FIRST_SWITCH)};
   }
 
   else if (i <= MIXSRC_LAST_LOGICAL_SWITCH) {
-    return getSwitch(SWSRC_FIRST_LOGICAL_SWITCH + i - MIXSRC_FIRST_LOGICAL_SWITCH) ? 1024 : -1024;
+    return {SOURCE_KIND_LOGICAL_SWITCH, (uint8_t)(i - MIXSRC_FIRST_LOGICAL_SWITCH)};
   } else if (i <= MIXSRC_LAST_TRAINER) {
-    int16_t x = trainerInput[i - MIXSRC_FIRST_TRAINER];
-    if (i < MIXSRC_FIRST_TRAINER + NUM_CAL_PPM) {
-      x -= g_eeGeneral.trainer.calib[i - MIXSRC_FIRST_TRAINER];
-    }
-    return x * 2;
+    return {SOURCE_KIND_TRAINER, (uint8_t)(i - MIXSRC_FIRST_TRAINER)};
   } else if (i <= MIXSRC_LAST_CH) {
-    return ex_chans[i - MIXSRC_FIRST_CH];
+    return {SOURCE_KIND_CHANNEL, (uint8_t)(i - MIXSRC_FIRST_CH)};
   }
 
   else if (i <= MIXSRC_LAST_GVAR) {
 #if defined(GVARS)
-    return GVAR_VALUE(i - MIXSRC_FIRST_GVAR, getGVarFlightMode(mixerCurrentFlightMode, i - MIXSRC_FIRST_GVAR));
+    return {SOURCE_KIND_GVAR, (uint8_t)(i - MIXSRC_FIRST_GVAR)};
 #else
-    if (valid != nullptr) *valid = false;
-    return 0;
+    return {SOURCE_KIND_NONE, 0};
 #endif
   }
 
   else if (i == MIXSRC_TX_VOLTAGE) {
-    return g_vbat100mV;
+    return {SOURCE_KIND_TX_VOLTAGE, 0};
   } else if (i < MIXSRC_FIRST_TIMER) {
     // TX_TIME + SPARES
 #if defined(RTCLOCK)
-    return (g_rtcTime % SECS_PER_DAY) / 60; // number of minutes from midnight
+    return {SOURCE_KIND_TX_TIME, 0};
 #else
-    if (valid != nullptr) *valid = false;
-    return 0;
+    return {SOURCE_KIND_NONE, 0};
 #endif
   } else if (i <= MIXSRC_LAST_TIMER) {
-    return timersStates[i - MIXSRC_FIRST_TIMER].val;
+    return {SOURCE_KIND_TIMER, (uint8_t)(i - MIXSRC_FIRST_TIMER)};
   }
 
   else if (i <= MIXSRC_LAST_TELEM) {
-    if (IS_FAI_FORBIDDEN(i)) {
-      if (valid != nullptr) *valid = false;
-      return 0;
+    div_t qr = div(i - MIXSRC_FIRST_TELEM, 3);
+    return {(uint8_t)(SOURCE_KIND_TELEM + qr.rem), (uint8_t)qr.quot};
+  } else {
+    return {SOURCE_KIND_NONE, 0};
+  }
+}
+
+// TODO same naming convention than the drawSource
+// *valid added to return status to Lua for invalid sources
+getvalue_t getSourceValue(SourceRef src, bool* valid)
+{
+  switch (src.kind) {
+    case SOURCE_KIND_INPUT:
+      return anas[src.index];
+
+#if defined(LUA_MODEL_SCRIPTS)
+    case SOURCE_KIND_LUA:
+      return scriptInputsOutputs[src.index / MAX_SCRIPT_OUTPUTS]
+          .outputs[src.index % MAX_SCRIPT_OUTPUTS]
+          .value;
+#endif
+
+    case SOURCE_KIND_STICK:
+      return calibratedAnalogs[inputMappingConvertMode(src.index)];
+
+    case SOURCE_KIND_ANALOG:
+      return calibratedAnalogs[src.index];
+
+#if defined(IMU)
+    case SOURCE_KIND_TILT_X:
+      return gyro.scaledX();
+
+    case SOURCE_KIND_TILT_Y:
+      return gyro.scaledY();
+#endif
+
+#if defined(SPACEMOUSE)
+    case SOURCE_KIND_SPACEMOUSE:
+      return get_spacemouse_value(src.index);
+#endif
+
+    case SOURCE_KIND_MIN:
+      return -RESX;
+
+    case SOURCE_KIND_MAX:
+      return RESX;
+
+#if defined(HELI)
+    case SOURCE_KIND_HELI:
+      return cyc_anas[src.index];
+#endif
+
+    case SOURCE_KIND_TRIM:
+    {
+      auto trim_value = getTrimValue(mixerCurrentFlightMode, src.index);
+      return calc1000toRESX((int16_t)8 * trim_value);
+    }
+
+    case SOURCE_KIND_SWITCH:
+    {
+      auto sw_idx = src.index;
+#if defined(FUNCTION_SWITCHES)
+      auto max_reg_switches = switchGetMaxSwitches();
+      if (sw_idx >= max_reg_switches) {
+        auto fct_idx = sw_idx - max_reg_switches;
+        auto max_fct_switches = switchGetMaxFctSwitches();
+        if (fct_idx < max_fct_switches) {
+          return _switch_2pos_lookup[getFSLogicalState(fct_idx)];
+        }
+      }
+#endif
+      auto sw_cfg = (SwitchConfig)SWITCH_CONFIG(sw_idx);
+      switch(sw_cfg) {
+      case SWITCH_TOGGLE:
+      case SWITCH_2POS:
+        return _switch_2pos_lookup[switchGetPosition(sw_idx)];
+      case SWITCH_3POS:
+        return _switch_3pos_lookup[switchGetPosition(sw_idx)];
+      default:
+        break;
+      }
+      break;
+    }
+
+    case SOURCE_KIND_LOGICAL_SWITCH:
+      return getSwitch(SWSRC_FIRST_LOGICAL_SWITCH + src.index) ? 1024 : -1024;
+
+    case SOURCE_KIND_TRAINER:
+    {
+      int16_t x = trainerInput[src.index];
+      if (src.index < NUM_CAL_PPM) {
+        x -= g_eeGeneral.trainer.calib[src.index];
+      }
+      return x * 2;
     }
-    i -= MIXSRC_FIRST_TELEM;
-    div_t qr = div(i, 3);
-    TelemetryItem & telemetryItem = telemetryItems[qr.quot];
-    switch (qr.rem) {
-      case 1:
+
+    case SOURCE_KIND_CHANNEL:
+      return ex_chans[src.index];
+
+#if defined(GVARS)
+    case SOURCE_KIND_GVAR:
+      return GVAR_VALUE(src.index, getGVarFlightMode(mixerCurrentFlightMode, src.index));
+#endif
+
+    case SOURCE_KIND_TX_VOLTAGE:
+      return g_vbat100mV;
+
+#if defined(RTCLOCK)
+    case SOURCE_KIND_TX_TIME:
+      return (g_rtcTime % SECS_PER_DAY) / 60; // number of minutes from midnight
+#endif
+
+    case SOURCE_KIND_TIMER:
+      return timersStates[src.index].val;
+
+    case SOURCE_KIND_TELEM:
+    case SOURCE_KIND_TELEM_MIN:
+    case SOURCE_KIND_TELEM_MAX:
+    {
+      if (IS_FAI_FORBIDDEN(MIXSRC_FIRST_TELEM + 3 * src.index))
+        break;
+      TelemetryItem & telemetryItem = telemetryItems[src.index];
+      if (src.kind == SOURCE_KIND_TELEM_MIN)
         return telemetryItem.valueMin;
-      case 2:
+      else if (src.kind == SOURCE_KIND_TELEM_MAX)
         return telemetryItem.valueMax;
-      default:
-        return telemetryItem.value;
+      return telemetryItem.value;
     }
-  } else {
-    if (valid != nullptr) *valid = false;
-    return 0;
   }
+
+  if (valid != nullptr) *valid = false;
+  return 0;
+}
+
+getvalue_t getValue(mixsrc_t i, bool* valid)
+{
+  return getSourceValue(resolveSource(i), valid);
 }
 
 void evalTrims()
@@ -769,13 +867,13 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
       getvalue_t v = 0;
       if (mode > e_perout_mode_inactive_flight_mode) {
         if (mixEnabled)
-          v = getValue(md->srcRaw);
+          v = getCachedSourceValue(mixSources[i], md->srcRaw);
         else
           continue;
       }
       else {
         mixsrc_t srcRaw = MIXSRC_FIRST_STICK + stickIndex;
-        v = getValue(srcRaw);
+        v = getCachedSourceValue(mixSources[i], srcRaw);
         srcRaw -= MIXSRC_FIRST_CH;
         if (srcRaw <= MIXSRC_LAST_CH-MIXSRC_FIRST_CH && md->destCh != srcRaw) {
           if (dirtyChannels & ((bitfield_channels_t)1 << srcRaw) & (passDirtyChannels|~(((bitfield_channels_t) 1 << md->destCh)-1)))
@@ -981,6 +1079,75 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
 
 
 
+void mixerStateSave(MixerState & state)
+{
+  memcpy(state.virtualInputsTrims, virtualInputsTrims, sizeof(state.virtualInputsTrims));
+  memcpy(state.anas, anas, sizeof(state.anas));
+  memcpy(state.trims, trims, sizeof(state.trims));
+  memcpy(state.chans, chans, sizeof(state.chans));
+  memcpy(state.act, act, sizeof(state.act));
+  memcpy(state.swOn, swOn, sizeof(state.swOn));
+  memcpy(state.calibratedAnalogs, calibratedAnalogs, sizeof(state.calibratedAnalogs));
+  memcpy(state.anaFilt, s_anaFilt, sizeof(state.anaFilt));
+#if defined(HELI)
+  memcpy(state.cyc_anas, cyc_anas, sizeof(state.cyc_anas));
+#endif
+  state.bpanaCenter = bpanaCenter;
+  state.mixWarning = mixWarning;
+  state.currentFlightMode = mixerCurrentFlightMode;
+}
+
+void mixerStateRestore(const MixerState & state)
+{
+  memcpy(virtualInputsTrims, state.virtualInputsTrims, sizeof(state.virtualInputsTrims));
+  memcpy(anas, state.anas, sizeof(state.anas));
+  memcpy(trims, state.trims, sizeof(state.trims));
+  memcpy(chans, state.chans, sizeof(state.chans));
+  memcpy(act, state.act, sizeof(state.act));
+  memcpy(swOn, state.swOn, sizeof(state.swOn));
+  memcpy(calibratedAnalogs, state.calibratedAnalogs, sizeof(state.calibratedAnalogs));
+  memcpy(s_anaFilt, state.anaFilt, sizeof(state.anaFilt));
+#if defined(HELI)
+  memcpy(cyc_anas, state.cyc_anas, sizeof(state.cyc_anas));
+#endif
+  bpanaCenter = state.bpanaCenter;
+  mixWarning = state.mixWarning;
+  mixerCurrentFlightMode = state.currentFlightMode;
+}
+
+// Evaluates the mixer of the current model in the given flight mode for each
+// value of one analog input in [from..to], all other inputs keeping their
+// current position. The mixer task is held for the whole sweep and the live
+// mixer state is restored afterwards. Logical switches are not re-evaluated
+// and slow (speed) mix lines report their current position.
+bool evalMixerSweep(uint8_t flightMode, uint8_t input, int16_t from, int16_t to,
+                    int16_t step, MixerSweepCallback callback, void * ctx)
+{
+  if (step <= 0 || input >= MAX_ANALOG_INPUTS)
+    return false;
+
+  // too large for the stack of the calling task
+  MixerState * saved = (MixerState *)malloc(sizeof(MixerState));
+  if (!saved)
+    return false;
+
+  mixerTaskLock();
+  mixerStateSave(*saved);
+
+  mixerCurrentFlightMode = flightMode;
+  for (int32_t value = from; value <= to; value += step) {
+    anaSetFiltered(input, value);
+    evalFlightModeMixes(e_perout_mode_inactive_flight_mode, 0);
+    callback(value, chans, ctx);
+  }
+
+  mixerStateRestore(*saved);
+  mixerTaskUnlock();
+
+  free(saved);
+  return true;
+}
+
 #define MAX_ACT 0xffff
 uint8_t lastFlightMode = 255; // TODO reinit everything here when the model changes, no???
 
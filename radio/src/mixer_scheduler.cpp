@@ -62,6 +62,12 @@ struct MixerSchedule {
 
 static MixerSchedule mixerSchedules[NUM_MODULES];
 
+#if defined(STM32)
+// set by each USB start-of-frame pacing the mixer,
+// cleared by the next timer reload
+static volatile bool usbSofPaced = false;
+#endif
+
 uint16_t getMixerSchedulerPeriod()
 {
 #if defined(HARDWARE_INTERNAL_MODULE)
@@ -82,6 +88,17 @@ uint16_t getMixerSchedulerPeriod()
   return MIXER_SCHEDULER_DEFAULT_PERIOD_US;
 }
 
+uint16_t getMixerSchedulerTimerPeriod()
+{
+#if defined(STM32)
+  if (usbSofPaced) {
+    usbSofPaced = false;
+    return MIXER_SCHEDULER_JOYSTICK_SOF_TIMEOUT_US;
+  }
+#endif
+  return getMixerSchedulerPeriod();
+}
+
 void mixerSchedulerInit()
 {
   memset(mixerSchedules, 0, sizeof(mixerSchedules));
@@ -124,4 +141,22 @@ void mixerSchedulerISRTrigger()
   portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
 }
 
+#if defined(STM32)
+void mixerSchedulerUsbSofTrigger()
+{
+  // modules keep their own pace
+#if defined(HARDWARE_INTERNAL_MODULE)
+  if (mixerSchedules[INTERNAL_MODULE].period) return;
+#endif
+#if defined(HARDWARE_EXTERNAL_MODULE)
+  if (mixerSchedules[EXTERNAL_MODULE].period) return;
+#endif
+
+  // restart the timer cycle in sync with the host polling,
+  // the timer ISR then triggers the mixer
+  usbSofPaced = true;
+  mixerSchedulerSoftTrigger();
+}
+#endif
+
 #endif
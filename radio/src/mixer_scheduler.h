@@ -26,6 +26,10 @@
 #define MIXER_SCHEDULER_DEFAULT_PERIOD_US  4000u // 4ms
 #define MIXER_SCHEDULER_JOYSTICK_PERIOD_US 1000u // 1ms
 
+// Timer fallback while the USB start-of-frame paces the mixer:
+// only fires when the host stops sending them (suspend)
+#define MIXER_SCHEDULER_JOYSTICK_SOF_TIMEOUT_US 2000u // 2ms
+
 #define MIN_REFRESH_RATE       850 /* us */
 #define MAX_REFRESH_RATE     50000 /* us */
 
@@ -58,9 +62,15 @@ void mixerSchedulerSoftTrigger();
 // Fetch the current scheduling period
 uint16_t getMixerSchedulerPeriod();
 
+// Fetch the period for the next scheduler timer cycle
+uint16_t getMixerSchedulerTimerPeriod();
+
 // Trigger mixer from an ISR
 void mixerSchedulerISRTrigger();
 
+// Trigger mixer from the USB start-of-frame interrupt (joystick mode)
+void mixerSchedulerUsbSofTrigger();
+
 #else
 
 #define mixerSchedulerInit()
@@ -75,7 +85,9 @@ void mixerSchedulerISRTrigger();
 #define mixerSchedulerSoftTrigger()
 
 #define getMixerSchedulerPeriod() (MIXER_SCHEDULER_DEFAULT_PERIOD_US)
+#define getMixerSchedulerTimerPeriod() (MIXER_SCHEDULER_DEFAULT_PERIOD_US)
 #define mixerSchedulerISRTrigger()
+#define mixerSchedulerUsbSofTrigger()
 
 #endif
 
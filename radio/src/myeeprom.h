@@ -238,6 +238,15 @@ enum TelemetrySensorType
   TELEM_TYPE_CALCULATED
 };
 
+// How sensors decoded from the internal and external modules are combined
+enum TelemetryLinkMode
+{
+  TELEM_LINKS_SHARED,     // one namespace, every link updates every sensor
+  TELEM_LINKS_SEPARATE,   // each module discovers and updates its own sensors
+  TELEM_LINKS_BEST_RSSI,  // one namespace, fed by the link with the best RSSI
+  TELEM_LINKS_FAILOVER,   // one namespace, fed by the first link still streaming
+};
+
 enum TelemetrySensorFormula
 {
   TELEM_FORMULA_ADD,
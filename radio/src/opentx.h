@@ -445,6 +445,13 @@ extern uint32_t availableMemory();
 
 void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms);
 void evalMixes(uint8_t tick10ms);
+
+void mixerStateSave(MixerState & state);
+void mixerStateRestore(const MixerState & state);
+
+typedef void (*MixerSweepCallback)(int16_t value, const int32_t * chans, void * ctx);
+bool evalMixerSweep(uint8_t flightMode, uint8_t input, int16_t from, int16_t to,
+                    int16_t step, MixerSweepCallback callback, void * ctx);
 void doMixerCalculations();
 void doMixerPeriodicUpdates();
 
@@ -452,7 +459,45 @@ void checkTrims();
 extern uint8_t currentBacklightBright;
 void perMain();
 
+enum SourceKind {
+  SOURCE_KIND_NONE,
+  SOURCE_KIND_INPUT,
+  SOURCE_KIND_LUA,
+  SOURCE_KIND_STICK,
+  SOURCE_KIND_ANALOG,
+  SOURCE_KIND_TILT_X,
+  SOURCE_KIND_TILT_Y,
+  SOURCE_KIND_SPACEMOUSE,
+  SOURCE_KIND_MIN,
+  SOURCE_KIND_MAX,
+  SOURCE_KIND_HELI,
+  SOURCE_KIND_TRIM,
+  SOURCE_KIND_SWITCH,
+  SOURCE_KIND_LOGICAL_SWITCH,
+  SOURCE_KIND_TRAINER,
+  SOURCE_KIND_CHANNEL,
+  SOURCE_KIND_GVAR,
+  SOURCE_KIND_TX_VOLTAGE,
+  SOURCE_KIND_TX_TIME,
+  SOURCE_KIND_TIMER,
+  SOURCE_KIND_TELEM,      // value, min and max: same order as the
+  SOURCE_KIND_TELEM_MIN,  // MIXSRC_FIRST_TELEM sources
+  SOURCE_KIND_TELEM_MAX,
+};
+
+// A source resolved once to its kind and the index of its value, so that
+// reading it does not walk through all the source ranges again
+struct SourceRef {
+  uint8_t kind;
+  uint8_t index;
+};
+
+SourceRef resolveSource(mixsrc_t i);
+getvalue_t getSourceValue(SourceRef src, bool* valid = nullptr);
 getvalue_t getValue(mixsrc_t i, bool* valid = nullptr);
+// Same as getValue(), resolving the source only when it differs from the
+// one stored in cache
+getvalue_t getCachedSourceValue(uint32_t & cache, mixsrc_t source);
 
 int8_t getMovedSource(uint8_t min);
 #define GET_MOVED_SOURCE(min, max) getMovedSource(min)
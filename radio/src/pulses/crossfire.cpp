@@ -59,7 +59,8 @@ uint8_t createCrossfireModelIDFrame(uint8_t moduleIdx, uint8_t * frame)
 }
 
 // Range for pulses (channels output) is [-1024:+1024]
-uint8_t createCrossfireChannelsFrame(uint8_t * frame, int16_t * pulses)
+// channels from nChannels onwards are sent at center
+uint8_t createCrossfireChannelsFrame(uint8_t * frame, int16_t * pulses, uint8_t nChannels)
 {
   uint8_t * buf = frame;
   *buf++ = MODULE_ADDRESS;
@@ -69,7 +70,8 @@ uint8_t createCrossfireChannelsFrame(uint8_t * frame, int16_t * pulses)
   uint32_t bits = 0;
   uint8_t bitsavailable = 0;
   for (int i=0; i<CROSSFIRE_CHANNELS_COUNT; i++) {
-    uint32_t val = limit(0, CROSSFIRE_CENTER + (CROSSFIRE_CENTER_CH_OFFSET(i) * 4) / 5 + (pulses[i] * 4) / 5, 2 * CROSSFIRE_CENTER);
+    int16_t pulse = (i < nChannels ? pulses[i] : 0);
+    uint32_t val = limit(0, CROSSFIRE_CENTER + (CROSSFIRE_CENTER_CH_OFFSET(i) * 4) / 5 + (pulse * 4) / 5, 2 * CROSSFIRE_CENTER);
     bits |= val << bitsavailable;
     bitsavailable += CROSSFIRE_CH_BITS;
     while (bitsavailable >= 8) {
@@ -99,8 +101,7 @@ static void setupPulsesCrossfire(uint8_t module, uint8_t*& p_buf,
       p_buf += createCrossfireModelIDFrame(module, p_buf);
       moduleState[module].counter = CRSF_FRAME_MODELID_SENT;
     } else {
-      /* TODO: nChannels */
-      p_buf += createCrossfireChannelsFrame(p_buf, channels);
+      p_buf += createCrossfireChannelsFrame(p_buf, channels, nChannels);
     }
   }
 }
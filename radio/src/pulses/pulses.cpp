@@ -554,9 +554,11 @@ void pulsesSendNextFrame(uint8_t module)
       state.settings_updated = 0;
     }
 
+    // only the channels configured for the module, never past the last output
     uint8_t channelStart = g_model.moduleData[module].channelsStart;
     int16_t* channels = &channelOutputs[channelStart];
-    uint8_t nChannels = 16;  // TODO: MAX_CHANNELS - channelsStart
+    uint8_t nChannels = limit<int8_t>(0, sentModuleChannels(module),
+                                      MAX_OUTPUT_CHANNELS - channelStart);
 
     auto buffer = _module_buffers[module]._buffer;
     drv->sendPulses(ctx, buffer, channels, nChannels);
@@ -98,6 +98,8 @@ const char YAMLFILE_CHECKSUM_TAG_NAME[] = "checksum";
 #define MULTI_FIRMWARE_EXT  ".bin"
 #define ELRS_FIRMWARE_EXT   ".elrs"
 #define YAML_EXT            ".yml"
+#define TMPFILE_EXT         ".tmp"
+#define SWAPFILE_EXT        ".swp"
 
 #if defined(COLORLCD)
 #define BITMAPS_EXT         BMP_EXT JPG_EXT PNG_EXT
@@ -120,6 +122,9 @@ const char YAMLFILE_CHECKSUM_TAG_NAME[] = "checksum";
   filename[sizeof(path)+sizeof(var)] = '\0'; \
   strcat(&filename[sizeof(path)], ext)
 
+// Logs reserve file space by chunks of this size
+#define LOGS_PREALLOC_SIZE  (1024 * 1024)
+
 extern uint8_t logDelay100ms;
 void logsInit();
 void logsClose();
@@ -692,11 +692,11 @@ bool ModelMap::renameLabel(const std::string &from, std::string to,
     if (modcell == modelslist.getCurrentModel()) {
       // If working on the current model, write current data to file instead
       memcpy(g_model.header.labels, modeldata->header.labels, LABELS_LENGTH);
-      fault = (writeFileYaml(path, get_modeldata_nodes(),
-                             (uint8_t *)&g_model, 0) != NULL);
+      fault = (writeFileYamlAtomic(path, get_modeldata_nodes(),
+                             (uint8_t *)&g_model) != NULL);
     } else {
-      fault = (writeFileYaml(path, get_modeldata_nodes(),
-                             (uint8_t *)modeldata, 0) != NULL);
+      fault = (writeFileYamlAtomic(path, get_modeldata_nodes(),
+                             (uint8_t *)modeldata) != NULL);
     }
 #if defined(SIMU)
     if (SIMU_SLEEP_OR_EXIT_MS(100)) break;
@@ -813,7 +813,7 @@ bool ModelMap::updateModelFile(ModelCell *cell)
 
   char path[256];
   getModelPath(path, cell->modelFilename);
-  fault = (writeFileYaml(path, get_modeldata_nodes(), (uint8_t *)modeldata, 0) !=
+  fault = (writeFileYamlAtomic(path, get_modeldata_nodes(), (uint8_t *)modeldata) !=
            NULL);
 
   free(modeldata);
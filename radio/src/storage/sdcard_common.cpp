@@ -191,6 +191,9 @@ void storageReadAll()
   // - screens disabled by default:
   g_eeGeneral.modelCustomScriptsDisabled = true;
   
+  // finish model writes interrupted by a power loss
+  recoverModelFiles();
+
   if (loadRadioSettings() != nullptr) {
     storageEraseAll(true);
   }
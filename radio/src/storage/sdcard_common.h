@@ -49,9 +49,13 @@ const char* writeFileBin(const char* fullpath, const uint8_t* data,
 const char *loadFileBin(const char *fullpath, uint8_t *data,
                         uint16_t maxsize, uint8_t *version);
 
-// writes a complete YAML file
+// writes a complete YAML file, preceded by its checksum if checksum is not null
 struct YamlNode;
-const char* writeFileYaml(const char* path, const YamlNode* root_node, uint8_t* data, uint16_t checksum);
+const char* writeFileYaml(const char* path, const YamlNode* root_node, uint8_t* data, uint16_t* checksum = nullptr);
+// same through a temporary file, the previous version stays intact until the new one is complete
+const char* writeFileYamlAtomic(const char* path, const YamlNode* root_node, uint8_t* data);
+// complete the model files replacement interrupted by a power loss
+void recoverModelFiles();
 
 void getModelPath(char * path, const char * filename, const char* pathName = STR_MODELS_PATH);
 
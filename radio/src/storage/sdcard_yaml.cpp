@@ -200,64 +200,79 @@ const char * loadRadioSettings()
 
 
 
-struct yaml_checksummer_ctx {
-    FRESULT result;
+// Output is collected into sector sized chunks, so that FatFs can write
+// them straight to the card instead of copying every fragment generated
+// by the tree walker into the file buffer.
+#define YAML_WRITER_BUFFER_SIZE 512
+
+// "checksum: " followed by up to 5 digits, padded with spaces
+#define YAML_CHECKSUM_DIGITS    5
+
+struct yaml_writer_ctx {
+    FIL*     file;
+    FRESULT  result;
     uint16_t checksum;
-    bool checksum_invalid;
+    bool     checksum_enabled;
+    uint16_t len;
+    char     buffer[YAML_WRITER_BUFFER_SIZE];
 };
 
-static bool yaml_checksummer(void* opaque, const char* str, size_t len)
+static bool yaml_writer_flush(yaml_writer_ctx* ctx)
 {
-    yaml_checksummer_ctx* ctx = (yaml_checksummer_ctx*)opaque;
+    UINT bytes_written;
 
-    ctx->checksum = crc16(0, (const uint8_t *) str, len, ctx->checksum);
-    return true;
-}
+    if (ctx->len == 0)
+        return true;
 
-bool YamlFileChecksum(const YamlNode* root_node, uint8_t* data, uint16_t* checksum)
-{
-    YamlTreeWalker tree;
-    tree.reset(root_node, data);
+#if defined(DEBUG_YAML)
+    TRACE_NOCRLF("%.*s",ctx->len,ctx->buffer);
+#endif
 
-    yaml_checksummer_ctx ctx;
-    ctx.result = FR_OK;
-    ctx.checksum = 0xFFFF;
-    ctx.checksum_invalid = false;
+    ctx->result = f_write(ctx->file, ctx->buffer, ctx->len, &bytes_written);
+    if ((ctx->result == FR_OK) && (bytes_written != ctx->len))
+        ctx->result = FR_DENIED; // disk full
 
-    if (!tree.generate(yaml_checksummer, &ctx)) {
-        if (ctx.result != FR_OK) {
-          ctx.checksum_invalid = true;
-          return false;
-        }
-    }
+    ctx->len = 0;
+    return ctx->result == FR_OK;
+}
 
-    if(checksum != NULL) {
-      *checksum = ctx.checksum;
+static bool yaml_writer_put(yaml_writer_ctx* ctx, const char* str, size_t len)
+{
+    while (len > 0) {
+        size_t chunk = min<size_t>(len, YAML_WRITER_BUFFER_SIZE - ctx->len);
+        memcpy(ctx->buffer + ctx->len, str, chunk);
+        ctx->len += chunk;
+        str += chunk;
+        len -= chunk;
+
+        if (ctx->len == YAML_WRITER_BUFFER_SIZE && !yaml_writer_flush(ctx))
+            return false;
     }
-
     return true;
 }
 
-
-struct yaml_writer_ctx {
-    FIL*    file;
-    FRESULT result;
-};
-
 static bool yaml_writer(void* opaque, const char* str, size_t len)
 {
-    UINT bytes_written;
     yaml_writer_ctx* ctx = (yaml_writer_ctx*)opaque;
 
-#if defined(DEBUG_YAML)
-    TRACE_NOCRLF("%.*s",len,str);
-#endif
+    // the checksum covers everything after the checksum line
+    if (ctx->checksum_enabled)
+        ctx->checksum = crc16(0, (const uint8_t *) str, len, ctx->checksum);
 
-    ctx->result = f_write(ctx->file, str, len, &bytes_written);
-    return (ctx->result == FR_OK) && (bytes_written == len);
+    return yaml_writer_put(ctx, str, len);
 }
 
-const char* writeFileYaml(const char* path, const YamlNode* root_node, uint8_t* data, uint16_t checksum)
+static void yaml_checksum_line(char* line, uint16_t checksum)
+{
+    char* p = strAppend(line, YAMLFILE_CHECKSUM_TAG_NAME);
+    p = strAppend(p, ": ");
+    char* digits = strAppendUnsigned(p, checksum);
+    while (digits < p + YAML_CHECKSUM_DIGITS)
+        *digits++ = ' ';
+    strcpy(digits, "\r\n");
+}
+
+const char* writeFileYaml(const char* path, const YamlNode* root_node, uint8_t* data, uint16_t* checksum)
 {
     FIL file;
 
@@ -271,39 +286,183 @@ const char* writeFileYaml(const char* path, const YamlNode* root_node, uint8_t*
     yaml_writer_ctx ctx;
     ctx.file = &file;
     ctx.result = FR_OK;
-
-    // Try to add CRC
-    if (checksum != 0) {
-      if (!yaml_writer(&ctx, YAMLFILE_CHECKSUM_TAG_NAME, strlen(YAMLFILE_CHECKSUM_TAG_NAME))) return NULL;
-      if (!yaml_writer(&ctx, ": ", 2)) return SDCARD_ERROR(FR_INVALID_PARAMETER);
-      const char* p_out = NULL;
-      p_out = yaml_unsigned2str((int)checksum);
-      if (p_out && !yaml_writer(&ctx, p_out, strlen(p_out))) return SDCARD_ERROR(FR_INVALID_PARAMETER);
-      yaml_writer(&ctx, "\r\n", 2);
+    ctx.checksum = 0xFFFF;
+    ctx.checksum_enabled = false;
+    ctx.len = 0;
+
+    // Reserve the checksum line, it is filled in once the whole tree has been written
+    char checksum_line[sizeof(YAMLFILE_CHECKSUM_TAG_NAME) + 2 + YAML_CHECKSUM_DIGITS + 2];
+    if (checksum) {
+        yaml_checksum_line(checksum_line, 0);
+        yaml_writer_put(&ctx, checksum_line, strlen(checksum_line));
+        ctx.checksum_enabled = true;
     }
 
+    tree.generate(yaml_writer, &ctx);
+    if (ctx.result == FR_OK)
+        yaml_writer_flush(&ctx);
 
-    if (!tree.generate(yaml_writer, &ctx)) {
-        if (ctx.result != FR_OK) {
+    if (ctx.result != FR_OK) {
+        f_close(&file);
+        return SDCARD_ERROR(ctx.result);
+    }
+
+    if (checksum) {
+        UINT bytes_written;
+        yaml_checksum_line(checksum_line, ctx.checksum);
+        result = f_lseek(&file, 0);
+        if (result == FR_OK)
+            result = f_write(&file, checksum_line, strlen(checksum_line), &bytes_written);
+        if (result != FR_OK) {
             f_close(&file);
-            return SDCARD_ERROR(ctx.result);
+            return SDCARD_ERROR(result);
         }
+        *checksum = ctx.checksum;
     }
 
-    f_close(&file);
+    result = f_close(&file);
+    if (result != FR_OK) {
+        return SDCARD_ERROR(result);
+    }
+    return NULL;
+}
+
+// The new version is written next to the file and only replaces it once
+// complete, so a power loss leaves either the old or the new version.
+static void getTmpFilePath(char* tmp, const char* path)
+{
+    strcpy(tmp, path);
+    char* ext = strrchr(tmp, '.');
+    strcpy(ext ? ext : tmp + strlen(tmp), TMPFILE_EXT);
+}
+
+const char* writeFileYamlAtomic(const char* path, const YamlNode* root_node, uint8_t* data)
+{
+    char tmp[256];
+    getTmpFilePath(tmp, path);
+
+    const char* error = writeFileYaml(tmp, root_node, data);
+    if (error) {
+        return error;
+    }
+
+    // f_rename() does not replace an existing file
+    f_unlink(path);
+    FRESULT result = f_rename(tmp, path);
+    if (result != FR_OK) {
+        return SDCARD_ERROR(result);
+    }
     return NULL;
 }
 
+// Finish an interrupted writeFileYamlAtomic(): the temporary file is only
+// complete if the original has already been removed. A left over temporary
+// file next to its original is kept, it is simply replaced on the next write.
+static void recoverFile(const char* path)
+{
+    FILINFO info;
+    if (f_stat(path, &info) == FR_OK) {
+        return;
+    }
+
+    char tmp[256];
+    getTmpFilePath(tmp, path);
+    if (f_stat(tmp, &info) == FR_OK) {
+        TRACE("recovering %s", path);
+        f_rename(tmp, path);
+    }
+}
+
+// swapModels() parks the first model in "<model1>-<model2>.swp" while the
+// second one is renamed, so that an interrupted swap can be completed
+static void getSwapFilePath(char* path, const char* model_idx_1, const char* model_idx_2)
+{
+    char fname[2 * MODELIDX_STRLEN + sizeof(SWAPFILE_EXT)];
+    strcpy(fname, model_idx_1);
+    strcat(fname, "-");
+    strcat(fname, model_idx_2);
+    strcat(fname, SWAPFILE_EXT);
+    getModelPath(path, fname, MODELS_PATH);
+}
+
+// Finish an interrupted swapModels(): if the first model file is still
+// missing the swap is undone, otherwise it is completed
+static void recoverSwapFile(const char* fname)
+{
+    const char* sep = strchr(fname, '-');
+    const char* ext = strrchr(fname, '.');
+    if (!sep || !ext || sep - fname != MODELIDX_STRLEN - 1 ||
+        ext - sep - 1 != MODELIDX_STRLEN - 1) {
+        return;
+    }
+
+    char model_idx_1[MODELIDX_STRLEN];
+    char model_idx_2[MODELIDX_STRLEN];
+    strncpy(model_idx_1, fname, sep - fname);
+    model_idx_1[sep - fname] = '\0';
+    strncpy(model_idx_2, sep + 1, ext - sep - 1);
+    model_idx_2[ext - sep - 1] = '\0';
+
+    char swp[256];
+    getModelPath(swp, fname, MODELS_PATH);
+
+    FILINFO info;
+    GET_FILENAME(fname1, MODELS_PATH, model_idx_1, YAML_EXT);
+    if (f_stat(fname1, &info) != FR_OK) {
+        TRACE("recovering %s", fname1);
+        f_rename(swp, fname1);
+        return;
+    }
+
+    GET_FILENAME(fname2, MODELS_PATH, model_idx_2, YAML_EXT);
+    if (f_stat(fname2, &info) != FR_OK) {
+        TRACE("recovering %s", fname2);
+        f_rename(swp, fname2);
+    }
+}
+
+void recoverModelFiles()
+{
+    DIR dir;
+    FILINFO info;
+
+    if (f_opendir(&dir, MODELS_PATH) != FR_OK) {
+        return;
+    }
+
+    for (;;) {
+        FRESULT res = f_readdir(&dir, &info);
+        if (res != FR_OK || info.fname[0] == 0) break;
+        if (info.fattrib & AM_DIR) continue;
+
+        const char* ext = strrchr(info.fname, '.');
+        if (!ext) continue;
+
+        if (!strcasecmp(ext, SWAPFILE_EXT)) {
+            recoverSwapFile(info.fname);
+            continue;
+        }
+
+        if (strcasecmp(ext, TMPFILE_EXT)) continue;
+
+        char path[256];
+        getModelPath(path, info.fname, MODELS_PATH);
+        strcpy(strrchr(path, '.'), YAML_EXT);
+        recoverFile(path);
+    }
+
+    f_closedir(&dir);
+}
+
 const char * writeGeneralSettings()
 {
     TRACE("YAML radio settings writer");
     uint16_t file_checksum = 0;
 
-    YamlFileChecksum(get_radiodata_nodes(), (uint8_t*)&g_eeGeneral, &file_checksum);
     g_eeGeneral.manuallyEdited = false;
 
     const char *p = writeFileYaml(RADIO_SETTINGS_TMPFILE_YAML_PATH, get_radiodata_nodes(),
-                         (uint8_t*)&g_eeGeneral, file_checksum);
+                         (uint8_t*)&g_eeGeneral, &file_checksum);
     TRACE("generalSettings written with checksum %u", file_checksum);
 
     if (p != NULL) {
@@ -388,7 +547,7 @@ const char * writeModelYaml(const char* filename)
     TRACE("YAML model writer");
     char path[256];
     getModelPath(path, filename);
-    return writeFileYaml(path, get_modeldata_nodes(), (uint8_t*)&g_model,0 );
+    return writeFileYamlAtomic(path, get_modeldata_nodes(), (uint8_t*)&g_model);
 }
 
 #if !defined(STORAGE_MODELSLIST)
@@ -485,7 +644,6 @@ void swapModels(uint8_t id1, uint8_t id2)
   getModelNumberStr(id2, model_idx_2);
 
   GET_FILENAME(fname1, MODELS_PATH, model_idx_1, YAML_EXT);
-  GET_FILENAME(fname1_tmp, MODELS_PATH, model_idx_1, ".tmp");
   GET_FILENAME(fname2, MODELS_PATH, model_idx_2, YAML_EXT);
 
   FILINFO fno;
@@ -502,10 +660,13 @@ void swapModels(uint8_t id1, uint8_t id2)
     return;
   }
 
+  char swp[256];
+  getSwapFilePath(swp, model_idx_1, model_idx_2);
+
   // just in case...
-  f_unlink(fname1_tmp);
+  f_unlink(swp);
 
-  if (f_rename(fname1, fname1_tmp) != FR_OK) {
+  if (f_rename(fname1, swp) != FR_OK) {
     TRACE("Error renaming 1");
     return;
   }
@@ -515,8 +676,8 @@ void swapModels(uint8_t id1, uint8_t id2)
     return;
   }
 
-  if (f_rename(fname1_tmp, fname2) != FR_OK) {
-    TRACE("Error renaming 1 tmp");
+  if (f_rename(swp, fname2) != FR_OK) {
+    TRACE("Error renaming swap file");
     return;
   }
 
@@ -32,9 +32,15 @@
   #define WRITE_DELAY_10MS 200
 #endif
 
+// changes made continuously (e.g. trims in flight) are still written at this interval
+#define WRITE_MAX_DELAY_10MS (10 * WRITE_DELAY_10MS)
+
 extern uint8_t   storageDirtyMsk;
 extern tmr10ms_t storageDirtyTime10ms;
-#define TIME_TO_WRITE()                (storageDirtyMsk && (tmr10ms_t)(get_tmr10ms() - storageDirtyTime10ms) >= (tmr10ms_t)WRITE_DELAY_10MS)
+extern tmr10ms_t storageDirtySince10ms;
+#define TIME_TO_WRITE()                (storageDirtyMsk && \
+                                        ((tmr10ms_t)(get_tmr10ms() - storageDirtyTime10ms) >= (tmr10ms_t)WRITE_DELAY_10MS || \
+                                         (tmr10ms_t)(get_tmr10ms() - storageDirtySince10ms) >= (tmr10ms_t)WRITE_MAX_DELAY_10MS))
 
 #if defined(RTC_BACKUP_RAM)
 #include "storage/rtc_backup.h"
@@ -35,8 +35,13 @@
   #endif
 #endif
 
+#if defined(LUA)
+  #include "telemetry/telemetry_history.h"
+#endif
+
 uint8_t   storageDirtyMsk;
 tmr10ms_t storageDirtyTime10ms;
+tmr10ms_t storageDirtySince10ms;
 
 #if defined(RTC_BACKUP_RAM)
 uint8_t   rambackupDirtyMsk = EE_GENERAL | EE_MODEL;
@@ -45,8 +50,14 @@ tmr10ms_t rambackupDirtyTime10ms;
 
 void storageDirty(uint8_t msk)
 {
-  storageDirtyMsk |= msk;
   storageDirtyTime10ms = get_tmr10ms();
+  if (!storageDirtyMsk)
+    storageDirtySince10ms = storageDirtyTime10ms;
+  storageDirtyMsk |= msk;
+
+  // curve points may have been edited
+  if (msk & EE_MODEL)
+    invalidateCurves();
 
 #if defined(RTC_BACKUP_RAM)
   rambackupDirtyMsk = storageDirtyMsk;
@@ -223,6 +234,10 @@ if(g_model.rssiSource) {
 #endif
 
   AUDIO_FLUSH();
+#if defined(LUA)
+  // scripts of the new model start their own history
+  telemetryHistory.reset();
+#endif
   flightReset(false);
 
   customFunctionsReset();
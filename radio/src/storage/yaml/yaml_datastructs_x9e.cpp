@@ -102,6 +102,13 @@ const struct YamlIdStr enum_TimerModes[] = {
   {  TMRMODE_THR_START, "THR_START"  },
   {  0, NULL  }
 };
+const struct YamlIdStr enum_TelemetryLinkMode[] = {
+  {  TELEM_LINKS_SHARED, "LINKS_SHARED"  },
+  {  TELEM_LINKS_SEPARATE, "LINKS_SEPARATE"  },
+  {  TELEM_LINKS_BEST_RSSI, "LINKS_BEST_RSSI"  },
+  {  TELEM_LINKS_FAILOVER, "LINKS_FAILOVER"  },
+  {  0, NULL  }
+};
 const struct YamlIdStr enum_MixerMultiplex[] = {
   {  MLTPX_ADD, "ADD"  },
   {  MLTPX_MUL, "MUL"  },
@@ -731,7 +738,7 @@ static const struct YamlNode struct_TelemetrySensor[] = {
   YAML_STRING("label", 4),
   YAML_UNSIGNED( "subId", 8 ),
   YAML_ENUM("type", 1, enum_TelemetrySensorType),
-  YAML_PADDING( 1 ),
+  YAML_UNSIGNED( "module", 1 ),
   YAML_UNSIGNED( "unit", 6 ),
   YAML_UNSIGNED( "prec", 2 ),
   YAML_UNSIGNED( "autoOffset", 1 ),
@@ -806,7 +813,7 @@ static const struct YamlNode struct_ModelData[] = {
   YAML_UNSIGNED( "showInstanceIds", 1 ),
   YAML_UNSIGNED( "checklistInteractive", 1 ),
   YAML_ENUM("hatsMode", 2, enum_HatsMode),
-  YAML_PADDING( 2 ),
+  YAML_ENUM("telemetryLinkMode", 2, enum_TelemetryLinkMode),
   YAML_SIGNED( "customThrottleWarningPosition", 8 ),
   YAML_UNSIGNED( "beepANACenter", 16 ),
   YAML_ARRAY("mixData", 160, 64, struct_MixData, NULL),
@@ -365,9 +365,12 @@ uint8_t switchGetMaxRow(uint8_t col)
   return lastrow;
 }
 
-getvalue_t getValueForLogicalSwitch(mixsrc_t i)
+// Sources of the logical switches v1 and v2 operands
+static uint32_t lsSources[MAX_LOGICAL_SWITCHES][2];
+
+getvalue_t getValueForLogicalSwitch(mixsrc_t i, uint32_t & cache)
 {
-  getvalue_t result = getValue(i);
+  getvalue_t result = getCachedSourceValue(cache, i);
   if (i>=MIXSRC_FIRST_INPUT && i<=MIXSRC_LAST_INPUT) {
     int8_t trimIdx = virtualInputsTrims[i-MIXSRC_FIRST_INPUT];
     if (trimIdx >= 0) {
@@ -431,10 +434,10 @@ bool getLogicalSwitch(uint8_t idx)
     result = (LS_LAST_VALUE(mixerCurrentFlightMode, idx) & (1<<0));
   }
   else {
-    getvalue_t x = getValueForLogicalSwitch(ls->v1);
+    getvalue_t x = getValueForLogicalSwitch(ls->v1, lsSources[idx][0]);
     getvalue_t y;
     if (s == LS_FAMILY_COMP) {
-      y = getValueForLogicalSwitch(ls->v2);
+      y = getValueForLogicalSwitch(ls->v2, lsSources[idx][1]);
 
       switch (ls->func) {
         case LS_FUNC_EQUAL:
@@ -29,6 +29,19 @@
 #if defined(USE_FLASH_FTL)
 #include "drivers/frftl.h"
 
+#if !defined(BOOT)
+#include "rtos.h"
+
+// Garbage collection only starts after the flash has not been
+// accessed for that long, to stay out of the way of bursts of IO
+#define FTL_GC_IDLE_DELAY_MS 1000
+
+static uint32_t _lastAccess = 0;
+#define FTL_ACCESSED() _lastAccess = RTOS_GET_MS()
+#else
+#define FTL_ACCESSED()
+#endif
+
 static FrFTL _frftl;
 
 static bool flashRead(uint32_t addr, uint8_t* buf, uint32_t len)
@@ -102,15 +115,9 @@ static DSTATUS spi_flash_status (BYTE lun)
 static DRESULT spi_flash_read(BYTE lun, BYTE * buff, DWORD sector, UINT count)
 {
 #if defined(USE_FLASH_FTL)
-  while(count) {
-
-    if(!ftlRead(&_frftl, sector, (uint8_t*)buff)) {
-      return RES_ERROR;
-    }
- 
-    buff += 512;
-    sector++;
-    count --;
+  FTL_ACCESSED();
+  if (!ftlRead(&_frftl, sector, count, (uint8_t*)buff)) {
+    return RES_ERROR;
   }
 #else
   flashSpiRead((uint32_t)sector * 512, buff, count * 512);
@@ -122,6 +129,7 @@ static DRESULT spi_flash_read(BYTE lun, BYTE * buff, DWORD sector, UINT count)
 static DRESULT spi_flash_write(BYTE lun, const BYTE *buff, DWORD sector, UINT count)
 {
 #if defined(USE_FLASH_FTL)
+  FTL_ACCESSED();
   if (!ftlWrite(&_frftl, sector, count, (uint8_t*)buff)) {
     return RES_ERROR;
   }
@@ -166,6 +174,7 @@ static DRESULT spi_flash_ioctl(BYTE lun, BYTE ctrl, void *buff)
 
   case CTRL_SYNC:
 #if defined(USE_FLASH_FTL)
+    FTL_ACCESSED();
     if (!ftlSync(&_frftl)) {
       res = RES_ERROR;
     }
@@ -176,6 +185,7 @@ static DRESULT spi_flash_ioctl(BYTE lun, BYTE ctrl, void *buff)
 
   case CTRL_TRIM:
 #if defined(USE_FLASH_FTL)
+    FTL_ACCESSED();
     if (!ftlTrim(&_frftl, *(DWORD*)buff, 1 + *((DWORD*)buff + 1) - *(DWORD*)buff)) {
       res = RES_ERROR;
     }
@@ -186,10 +196,25 @@ static DRESULT spi_flash_ioctl(BYTE lun, BYTE ctrl, void *buff)
   return res;
 }
 
+#if defined(USE_FLASH_FTL) && !defined(BOOT)
+static void spi_flash_idle(BYTE lun)
+{
+  if (RTOS_GET_MS() - _lastAccess < FTL_GC_IDLE_DELAY_MS) {
+    return;
+  }
+
+  // a single page erase per call keeps the calling task responsive
+  ftlGarbageCollect(&_frftl, 1);
+}
+#endif
+
 const diskio_driver_t spi_flash_diskio_driver = {
   .initialize = spi_flash_initialize,
   .status = spi_flash_status,
   .read = spi_flash_read,
   .write = spi_flash_write,
   .ioctl = spi_flash_ioctl,
+#if defined(USE_FLASH_FTL) && !defined(BOOT)
+  .idle = spi_flash_idle,
+#endif
 };
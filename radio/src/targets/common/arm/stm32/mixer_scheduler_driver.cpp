@@ -78,7 +78,7 @@ extern "C" void MIXER_SCHEDULER_TIMER_IRQHandler(void)
   mixerSchedulerDisableTrigger();
 
   // set next period
-  MIXER_SCHEDULER_TIMER->ARR = getMixerSchedulerPeriod() - 1;
+  MIXER_SCHEDULER_TIMER->ARR = getMixerSchedulerTimerPeriod() - 1;
 
   // trigger mixer start
   mixerSchedulerISRTrigger();
@@ -38,6 +38,8 @@
 static uint32_t _adc_input_mask;
 static uint32_t _adc_input_inhibt_mask = 0;
 static volatile uint32_t _adc_inhibit_mask;
+// inhibited inputs when the current conversion was started
+static uint32_t _adc_run_inhibit_mask;
 
 // DMA buffers
 static uint16_t _adc_dma_buffer[MAX_ADC_INPUTS] __DMA;
@@ -485,6 +487,10 @@ bool stm32_hal_adc_start_read(const stm32_adc_t* ADCs, uint8_t n_ADC,
   _adc_inputs = inputs;
   _adc_n_inputs = n_inputs;
 
+  // enabling an internal channel while converting would only
+  // sum part of the oversampling runs for that channel
+  _adc_run_inhibit_mask = _adc_inhibit_mask;
+
   memclear(_adc_oversampling, sizeof(_adc_oversampling));
   adc_start_read(_adc_ADCs, _adc_n_ADC);
 
@@ -503,7 +509,7 @@ static void copy_adc_values(uint16_t* src, const stm32_adc_t* adc,
     }
 
     // skip sampled but inhibited channels
-    if (_adc_inhibit_mask & (1 << channel)) {
+    if (_adc_run_inhibit_mask & (1 << channel)) {
       src++;
       continue;
     }
@@ -537,6 +543,11 @@ void stm32_hal_adc_wait_completion(const stm32_adc_t* ADCs, uint8_t n_ADC,
   }
 }
 
+bool stm32_hal_adc_check_completion()
+{
+  return _adc_completed;
+}
+
 void stm32_hal_adc_disable_oversampling()
 {
   _adc_oversampling_disabled = 1;
@@ -559,11 +570,13 @@ static void _adc_chain_conversions(const stm32_adc_t* adc)
   }
 
   auto adcValues = getAnalogValues();
+  adcValuesWriteBegin();
   for (uint8_t i = 0; i < _adc_n_inputs; i++) {
     if (~_adc_input_mask & (1 << i)) continue;
-    if (_adc_inhibit_mask & (1 << i)) continue;
+    if (_adc_run_inhibit_mask & (1 << i)) continue;
     adcValues[i] = _adc_oversampling[i] / OVERSAMPLING;
   }
+  adcValuesWriteEnd();
 
   // we're done!
   _adc_completed = 1;
@@ -61,6 +61,9 @@ bool stm32_hal_adc_start_read(const stm32_adc_t* ADCs, uint8_t n_ADC,
 void stm32_hal_adc_wait_completion(const stm32_adc_t* ADCs, uint8_t n_ADC,
                                    const stm32_adc_input_t* inputs, uint8_t n_inputs);
 
+// non-blocking variant of stm32_hal_adc_wait_completion()
+bool stm32_hal_adc_check_completion();
+
 void stm32_hal_adc_disable_oversampling();
 
 void stm32_hal_adc_dma_isr(const stm32_adc_t* adc);
@@ -142,6 +142,17 @@ bool usbStarted()
 
 #if !defined(BOOT)
 #include "globals.h"
+#include "mixer_scheduler.h"
+
+/*
+  Called from the USB start-of-frame interrupt in joystick mode:
+  the mixer is run in step with the host polling, so that every
+  report is computed right before it is read.
+*/
+extern "C" void usbJoystickStartOfFrame()
+{
+  mixerSchedulerUsbSofTrigger();
+}
 
 /*
   Prepare and send new USB data packet
@@ -149,48 +160,54 @@ bool usbStarted()
   The format of HID_Buffer is defined by
   USB endpoint description can be found in
   file usb_hid_joystick.c, variable HID_JOYSTICK_ReportDesc
+
+  Reports are built after every mixer run into the buffer that is
+  not being transmitted, and queued as soon as the endpoint is free.
 */
 void usbJoystickUpdate()
 {
 #if !defined(USBJ_EX)
-  static uint8_t HID_Buffer[HID_IN_PACKET];
-
-  // test to se if TX buffer is free
-  if (USBD_HID_SendReport(&USB_OTG_dev, 0, 0) == USBD_OK) {
-    //buttons
-    HID_Buffer[0] = 0;
-    HID_Buffer[1] = 0;
-    HID_Buffer[2] = 0;
-    for (int i = 0; i < 8; ++i) {
-      if ( channelOutputs[i+8] > 0 ) {
-        HID_Buffer[0] |= (1 << i);
-      }
-      if ( channelOutputs[i+16] > 0 ) {
-        HID_Buffer[1] |= (1 << i);
-      }
-      if ( channelOutputs[i+24] > 0 ) {
-        HID_Buffer[2] |= (1 << i);
-      }
+  static uint8_t HID_Buffers[2][HID_IN_PACKET];
+  static uint8_t HID_Index = 0;
+  uint8_t * HID_Buffer = HID_Buffers[HID_Index];
+
+  //buttons
+  HID_Buffer[0] = 0;
+  HID_Buffer[1] = 0;
+  HID_Buffer[2] = 0;
+  for (int i = 0; i < 8; ++i) {
+    if ( channelOutputs[i+8] > 0 ) {
+      HID_Buffer[0] |= (1 << i);
     }
+    if ( channelOutputs[i+16] > 0 ) {
+      HID_Buffer[1] |= (1 << i);
+    }
+    if ( channelOutputs[i+24] > 0 ) {
+      HID_Buffer[2] |= (1 << i);
+    }
+  }
 
-    //analog values
-    //uint8_t * p = HID_Buffer + 1;
-    for (int i = 0; i < 8; ++i) {
+  //analog values
+  //uint8_t * p = HID_Buffer + 1;
+  for (int i = 0; i < 8; ++i) {
 
-      int16_t value = channelOutputs[i] + 1024;
-      if ( value > 2047 ) value = 2047;
-      else if ( value < 0 ) value = 0;
-      HID_Buffer[i*2 +3] = static_cast<uint8_t>(value & 0xFF);
-      HID_Buffer[i*2 +4] = static_cast<uint8_t>((value >> 8) & 0x07);
+    int16_t value = channelOutputs[i] + 1024;
+    if ( value > 2047 ) value = 2047;
+    else if ( value < 0 ) value = 0;
+    HID_Buffer[i*2 +3] = static_cast<uint8_t>(value & 0xFF);
+    HID_Buffer[i*2 +4] = static_cast<uint8_t>((value >> 8) & 0x07);
 
-    }
-    USBD_HID_SendReport(&USB_OTG_dev, HID_Buffer, HID_IN_PACKET);
+  }
+
+  // sent only if TX buffer is free
+  if (USBD_HID_SendReport(&USB_OTG_dev, HID_Buffer, HID_IN_PACKET) == USBD_OK) {
+    HID_Index ^= 1;
   }
 #else
-  // test to se if TX buffer is free
-  if (USBD_HID_SendReport(&USB_OTG_dev, 0, 0) == USBD_OK) {
-    usbReport_t ret = usbReport();
-    USBD_HID_SendReport(&USB_OTG_dev, ret.ptr, ret.size);
+  usbReport_t ret = usbReport();
+  // sent only if TX buffer is free
+  if (USBD_HID_SendReport(&USB_OTG_dev, ret.ptr, ret.size) == USBD_OK) {
+    usbReportSwap();
   }
 #endif
 }
@@ -80,6 +80,11 @@ static uint8_t  USBD_HID_Setup (void  *pdev,
 static const uint8_t  *USBD_HID_GetCfgDesc (uint8_t speed, uint16_t *length);
 
 static uint8_t  USBD_HID_DataIn (void  *pdev, uint8_t epnum);
+
+static uint8_t  USBD_HID_SOF (void  *pdev);
+
+// defined in usb_driver.cpp
+void usbJoystickStartOfFrame(void);
 /**
   * @}
   */ 
@@ -160,7 +165,7 @@ const USBD_Class_cb_TypeDef  USBD_HID_cb =
   NULL, /*EP0_RxReady*/
   USBD_HID_DataIn, /*DataIn*/
   NULL, /*DataOut*/
-  NULL, /*SOF */
+  USBD_HID_SOF, /*SOF */
   NULL,
   NULL,      
   USBD_HID_GetCfgDesc,
@@ -470,6 +475,24 @@ static uint8_t  USBD_HID_DataIn (void  *pdev,
   return USBD_OK;
 }
 
+/**
+  * @brief  USBD_HID_SOF
+  *         handle Start Of Frame
+  * @param  pdev: device instance
+  * @retval status
+
+    Called every 1ms at full speed. The host polls the IN endpoint
+    at the same rate (bInterval = 1), so the mixer is started here
+    to have a fresh report ready for the next poll.
+  */
+static uint8_t  USBD_HID_SOF (void  *pdev)
+{
+  if (((USB_OTG_CORE_HANDLE *)pdev)->dev.device_status == USB_OTG_CONFIGURED) {
+    usbJoystickStartOfFrame();
+  }
+  return USBD_OK;
+}
+
 /**
   * @}
   */ 
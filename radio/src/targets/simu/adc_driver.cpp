@@ -56,6 +56,12 @@ static bool simu_start_conversion()
   return true;
 }
 
+// conversions are instantaneous
+static bool simu_check_completion()
+{
+  return true;
+}
+
 extern const etx_hal_adc_driver_t simu_adc_driver;
 
 const etx_hal_adc_driver_t simu_adc_driver = {
@@ -64,4 +70,5 @@ const etx_hal_adc_driver_t simu_adc_driver = {
   .init = nullptr,
   .start_conversion = simu_start_conversion,
   .wait_completion = nullptr,
+  .check_completion = simu_check_completion,
 };
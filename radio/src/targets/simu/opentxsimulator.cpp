@@ -22,6 +22,7 @@
 #include "opentxsimulator.h"
 #include "opentx.h"
 #include "simulcd.h"
+#include "telemetry_replay.h"
 #include "switches.h"
 
 #include "hal/adc_driver.h"
@@ -422,6 +423,21 @@ void OpenTxSimulator::sendTelemetry(const QByteArray data)
                               data.count());
 }
 
+void OpenTxSimulator::replayTelemetry(const QString & filename, quint8 protocol, quint16 speed)
+{
+  telemetryReplay.stop();
+  if (filename.isEmpty() || protocol >= TELEMETRY_REPLAY_COUNT)
+    return;
+
+  if (!telemetryReplay.load(filename.toLocal8Bit().constData())) {
+    ETXS_DBG << "no telemetry in" << filename;
+    return;
+  }
+
+  telemetryReplay.start(INTERNAL_MODULE, (TelemetryReplayProtocol)protocol, speed,
+                        simuTimerMicros() / 1000);
+}
+
 uint8_t OpenTxSimulator::getSensorInstance(uint16_t id, uint8_t defaultValue)
 {
   for (int i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
@@ -474,6 +490,28 @@ const int OpenTxSimulator::getCapability(Capability cap)
   return ret;
 }
 
+static void addMixerSweepPoint(int16_t value, const int32_t * chans, void * ctx)
+{
+  auto points = static_cast<QVector<SimulatorInterface::MixerSweepPoint> *>(ctx);
+  SimulatorInterface::MixerSweepPoint point;
+  memset(&point, 0, sizeof(point));
+  point.value = value;
+  for (int i = 0; i < std::min<int>(MAX_OUTPUT_CHANNELS, CPN_MAX_CHNOUT); i++) {
+    point.ex_chans[i] = chans[i] / 256;
+  }
+  points->append(point);
+}
+
+QVector<SimulatorInterface::MixerSweepPoint> OpenTxSimulator::sweepMixer(quint8 flightMode, quint8 input,
+                                                                        qint16 from, qint16 to, qint16 step)
+{
+  QVector<MixerSweepPoint> points;
+  if (isRunning() && flightMode < MAX_FLIGHT_MODES) {
+    evalMixerSweep(flightMode, input, from, to, step, addMixerSweepPoint, &points);
+  }
+  return points;
+}
+
 void OpenTxSimulator::setLuaStateReloadPermanentScripts()
 {
 #if defined(LUA)
@@ -527,6 +565,8 @@ void OpenTxSimulator::run()
 
   per10ms();
 
+  telemetryReplay.wakeup(simuTimerMicros() / 1000);
+
   checkLcdChanged();
 
   if (!(loops % 5)) {
@@ -569,68 +609,58 @@ void OpenTxSimulator::checkOutputsChanged()
   uint8_t i, idx;
   const uint8_t phase = getFlightMode();  // opentx.cpp
 
+  // Channels, mixes, logical switches and gvars are published as a single
+  // snapshot instead of one queued signal per changed value.
+  TxOutputs outputs;
+  outputs.chansLimit = (g_model.extendedLimits ? limit * LIMIT_EXT_PERCENT / 100 : limit);
+  outputs.ex_chansLimit = limit * 2;
+
   for (i=0; i < chansDim; i++) {
-    if (lastOutputs.chans[i] != channelOutputs[i] || m_resetOutputsData) {
-      emit channelOutValueChange(i, channelOutputs[i], (g_model.extendedLimits ? limit * LIMIT_EXT_PERCENT / 100 : limit));
-      emit outputValueChange(OUTPUT_SRC_CHAN_OUT, i, channelOutputs[i]);
-      lastOutputs.chans[i] = channelOutputs[i];
-    }
-    if (lastOutputs.ex_chans[i] != ex_chans[i] || m_resetOutputsData) {
-      emit channelMixValueChange(i, ex_chans[i], limit * 2);
-      emit outputValueChange(OUTPUT_SRC_CHAN_MIX, i, ex_chans[i]);
-      lastOutputs.ex_chans[i] = ex_chans[i];
-    }
+    outputs.chans[i] = channelOutputs[i];
+    outputs.ex_chans[i] = ex_chans[i];
   }
 
   for (i=0; i < MAX_LOGICAL_SWITCHES; i++) {
-    tmpVal = (qint32)GET_SWITCH_BOOL(SWSRC_FIRST_LOGICAL_SWITCH+i);
-    if (lastOutputs.vsw[i] != (bool)tmpVal || m_resetOutputsData) {
-      emit virtualSwValueChange(i, tmpVal);
-      emit outputValueChange(OUTPUT_SRC_VIRTUAL_SW, i, tmpVal);
-      lastOutputs.vsw[i] = tmpVal;
+    outputs.vsw[i] = GET_SWITCH_BOOL(SWSRC_FIRST_LOGICAL_SWITCH+i);
+  }
+
+#if defined(GVAR_VALUE) && defined(GVARS)
+  gVarMode_t gvar;
+  for (uint8_t gv=0; gv < MAX_GVARS; gv++) {
+    gvar.prec = g_model.gvars[gv].prec;
+    gvar.unit = g_model.gvars[gv].unit;
+    for (uint8_t fm=0; fm < MAX_FLIGHT_MODES; fm++) {
+      gvar.mode = fm;
+      gvar.value = (int16_t)GVAR_VALUE(gv, getGVarFlightMode(fm, gv));
+      outputs.gvars[fm][gv] = gvar;
     }
   }
+#endif
 
   for (i=0; i < Board::TRIM_AXIS_COUNT; i++) {
     idx = inputMappingConvertMode(i);
     tmpVal = getTrimValue(getTrimFlightMode(phase, idx), idx);
+    outputs.trims[i] = tmpVal;
     if (lastOutputs.trims[i] != tmpVal || m_resetOutputsData) {
       emit trimValueChange(i, tmpVal);
-      emit outputValueChange(OUTPUT_SRC_TRIM_VALUE, i, tmpVal);
-      lastOutputs.trims[i] = tmpVal;
     }
   }
 
-  tmpVal = g_model.extendedTrims ? TRIM_EXTENDED_MAX : TRIM_MAX;
-  if (lastOutputs.trimRange != tmpVal || m_resetOutputsData) {
-    emit trimRangeChange(Board::TRIM_AXIS_COUNT, -tmpVal, tmpVal);
-    emit outputValueChange(OUTPUT_SRC_TRIM_RANGE, Board::TRIM_AXIS_COUNT, tmpVal);
-    lastOutputs.trimRange = tmpVal;
+  outputs.trimRange = g_model.extendedTrims ? TRIM_EXTENDED_MAX : TRIM_MAX;
+  if (lastOutputs.trimRange != outputs.trimRange || m_resetOutputsData) {
+    emit trimRangeChange(Board::TRIM_AXIS_COUNT, -outputs.trimRange, outputs.trimRange);
   }
 
-  if (lastOutputs.phase != phase || m_resetOutputsData) {
+  outputs.phase = phase;
+  if (lastOutputs.phase != outputs.phase || m_resetOutputsData) {
     emit phaseChanged(phase, getCurrentPhaseName());
-    emit outputValueChange(OUTPUT_SRC_PHASE, 0, qint16(phase));
-    lastOutputs.phase = phase;
   }
 
-#if defined(GVAR_VALUE) && defined(GVARS)
-  gVarMode_t gvar;
-  for (uint8_t gv=0; gv < MAX_GVARS; gv++) {
-    gvar.prec = g_model.gvars[gv].prec;
-    gvar.unit = g_model.gvars[gv].unit;
-    for (uint8_t fm=0; fm < MAX_FLIGHT_MODES; fm++) {
-      gvar.mode = fm;
-      gvar.value = (int16_t)GVAR_VALUE(gv, getGVarFlightMode(fm, gv));
-      tmpVal = gvar;
-      if (lastOutputs.gvars[fm][gv] != tmpVal || m_resetOutputsData) {
-        lastOutputs.gvars[fm][gv] = tmpVal;
-        emit gVarValueChange(gv, tmpVal);
-        emit outputValueChange(OUTPUT_SRC_GVAR, gv, tmpVal);
-      }
-    }
+  // both snapshots are zero-filled on construction, so padding compares equal
+  if (memcmp(&lastOutputs, &outputs, sizeof(TxOutputs)) || m_resetOutputsData) {
+    emit outputsChanged(outputs);
+    memcpy(&lastOutputs, &outputs, sizeof(TxOutputs));
   }
-#endif
 
   m_resetOutputsData = false;
 }
@@ -56,6 +56,8 @@ class DLLEXPORT OpenTxSimulator : public SimulatorInterface
     virtual uint8_t getSensorInstance(uint16_t id, uint8_t defaultValue = 0);
     virtual uint16_t getSensorRatio(uint16_t id);
     virtual const int getCapability(Capability cap);
+    virtual QVector<MixerSweepPoint> sweepMixer(quint8 flightMode, quint8 input,
+                                                qint16 from, qint16 to, qint16 step);
 
     static QVector<QIODevice *> tracebackDevices;
 
@@ -79,6 +81,7 @@ class DLLEXPORT OpenTxSimulator : public SimulatorInterface
     virtual void lcdFlushed();
     virtual void setTrainerTimeout(uint16_t ms);
     virtual void sendTelemetry(const QByteArray data);
+    virtual void replayTelemetry(const QString & filename, quint8 protocol, quint16 speed);
     virtual void setLuaStateReloadPermanentScripts();
     virtual void addTracebackDevice(QIODevice * device);
     virtual void removeTracebackDevice(QIODevice * device);
@@ -42,11 +42,13 @@
 
 #if MSVC_BUILD
   #include <direct.h>
+  #include <io.h>
   #include <stdlib.h>
   #include <sys/utime.h>
   #define mkdir(s, f) _mkdir(s)
 #else
   #include <sys/time.h>
+  #include <unistd.h>
   #include <utime.h>
 #endif
 
@@ -334,8 +336,22 @@ FRESULT f_open (FIL * fil, const TCHAR *name, BYTE flag)
     fil->obj.objsize = tmp.st_size;
     fil->fptr = 0;
   }
-  fil->obj.fs = (FATFS*)fopen(realPath.c_str(), (flag & FA_WRITE) ? ((flag & FA_CREATE_ALWAYS) ? "wb+" : "ab+") : "rb");
+  if ((flag & FA_OPEN_APPEND) == FA_OPEN_APPEND) {
+    // not "ab+": writes must go to fptr, so that the file can be expanded
+    // and written from its start, or stretched by seeking past its end
+    fil->obj.fs = (FATFS*)fopen(realPath.c_str(), "rb+");
+    if (!fil->obj.fs)
+      fil->obj.fs = (FATFS*)fopen(realPath.c_str(), "wb+");
+  }
+  else {
+    fil->obj.fs = (FATFS*)fopen(realPath.c_str(), (flag & FA_WRITE) ? ((flag & FA_CREATE_ALWAYS) ? "wb+" : "ab+") : "rb");
+  }
+  fil->flag = flag;
   fil->fptr = 0;
+  if (fil->obj.fs && (flag & FA_OPEN_APPEND) == FA_OPEN_APPEND) {
+    fseek((FILE*)fil->obj.fs, 0, SEEK_END);
+    fil->fptr = ftell((FILE*)fil->obj.fs);
+  }
   if (fil->obj.fs) {
     TRACE_SIMPGMSPACE("f_open(%s, %x) = %p (FIL %p)", path.c_str(), flag, fil->obj.fs, fil);
     return FR_OK;
@@ -376,9 +392,24 @@ TCHAR * f_gets (TCHAR* buff, int len, FIL* fil)
   return buff;
 }
 
+static bool resizeFile(FILE* file, long size)
+{
+  fflush(file);
+#if MSVC_BUILD
+  return _chsize(_fileno(file), size) == 0;
+#else
+  return ftruncate(fileno(file), size) == 0;
+#endif
+}
+
 FRESULT f_lseek (FIL* fil, DWORD offset)
 {
   if (fil && fil->obj.fs) {
+    // as with FatFs, seeking past the end of a file opened for writing
+    // stretches it
+    if ((fil->flag & FA_WRITE) && offset > f_size(fil) &&
+        !resizeFile((FILE*)fil->obj.fs, offset))
+      return FR_DENIED;
     fseek((FILE*)fil->obj.fs, offset, SEEK_SET);
     fil->fptr = offset;
   }
@@ -398,6 +429,28 @@ UINT f_size(FIL* fil)
   return 0;
 }
 
+// Allocation is not contiguous on the host, only the size is set
+FRESULT f_expand (FIL* fil, FSIZE_t size, BYTE opt)
+{
+  if (!fil || !fil->obj.fs || !(fil->flag & FA_WRITE) || size == 0 ||
+      f_size(fil) != 0)
+    return FR_DENIED;
+  if (!resizeFile((FILE*)fil->obj.fs, size))
+    return FR_DENIED;
+  TRACE_SIMPGMSPACE("f_expand(%p) %u", fil->obj.fs, size);
+  return FR_OK;
+}
+
+FRESULT f_truncate (FIL* fil)
+{
+  if (fil && fil->obj.fs) {
+    if (!resizeFile((FILE*)fil->obj.fs, fil->fptr))
+      return FR_DENIED;
+    TRACE_SIMPGMSPACE("f_truncate(%p) %u", fil->obj.fs, fil->fptr);
+  }
+  return FR_OK;
+}
+
 FRESULT f_close (FIL * fil)
 {
   TRACE_SIMPGMSPACE("f_close(%p) (FIL:%p)", fil->obj.fs, fil);
@@ -617,6 +670,7 @@ FRESULT f_getfree (const TCHAR* path, DWORD* nclst, FATFS** fatfs)
 
 void storageInit() {}
 void storagePreMountHook() {}
+void storageIdle() {}
 bool storageIsPresent() { return true; }
 
 #endif  // #if defined(SIMU_USE_SDCARD)
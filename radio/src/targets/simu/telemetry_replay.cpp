@@ -0,0 +1,249 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "telemetry_replay.h"
+#include "opentx.h"
+
+#if defined(CROSSFIRE)
+  #include "telemetry/crossfire.h"
+#endif
+
+#if defined(GHOST)
+  #include "telemetry/ghost.h"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+
+TelemetryReplay telemetryReplay;
+
+static int hexDigit(char c)
+{
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  return -1;
+}
+
+bool TelemetryReplay::load(const char* filename)
+{
+  FILE* f = fopen(filename, "rb");
+  if (!f) return false;
+
+  std::vector<char> text;
+  char block[4096];
+  size_t count;
+  while ((count = fread(block, 1, sizeof(block), f)) > 0)
+    text.insert(text.end(), block, block + count);
+  fclose(f);
+
+  return parse(text.data(), text.size()) > 0;
+}
+
+void TelemetryReplay::clear()
+{
+  running = false;
+  chunks.clear();
+  data.clear();
+}
+
+uint32_t TelemetryReplay::parse(const char* text, size_t len)
+{
+  clear();
+
+  static constexpr uint32_t DAY_MS = 24 * 3600 * 1000;
+  uint32_t dayOffset = 0;
+  uint32_t lastMs = 0;
+
+  const char* end = text + len;
+  while (text < end) {
+    const char* eol = (const char*)memchr(text, '\n', end - text);
+    if (!eol) eol = end;
+
+    // "YYYY-MM-DD,HH:MM:SS.mmm:", fixed width as written by the radio
+    char line[32];
+    size_t lineLen = std::min<size_t>(eol - text, sizeof(line) - 1);
+    memcpy(line, text, lineLen);
+    line[lineLen] = '\0';
+
+    int year, month, day, hour, min, sec, ms, header = 0;
+    if (sscanf(line, "%d-%d-%d,%d:%d:%d.%d:%n", &year, &month, &day, &hour,
+               &min, &sec, &ms, &header) == 7 && header > 0) {
+      uint32_t timeMs = ((hour * 60 + min) * 60 + sec) * 1000 + ms + dayOffset;
+      if (timeMs + DAY_MS / 2 < lastMs) {
+        // capture went past midnight, smaller steps back are clock
+        // corrections and replayed without delay
+        dayOffset += DAY_MS;
+        timeMs += DAY_MS;
+      }
+      lastMs = timeMs;
+
+      Chunk chunk = {timeMs, (uint32_t)data.size(), 0};
+      const char* p = text + header;
+      while (eol - p >= 3 && p[0] == ' ') {
+        int hi = hexDigit(p[1]), lo = hexDigit(p[2]);
+        if (hi < 0 || lo < 0) break;
+        data.push_back((hi << 4) | lo);
+        chunk.count++;
+        p += 3;
+      }
+      if (chunk.count) chunks.push_back(chunk);
+    }
+
+    text = eol + 1;
+  }
+
+  return chunks.size();
+}
+
+void TelemetryReplay::start(uint8_t module, TelemetryReplayProtocol protocol,
+                            uint16_t speed, uint32_t nowMs)
+{
+  this->module = module;
+  this->protocol = protocol;
+  this->speed = speed;
+  startMs = nowMs;
+  next = 0;
+  bufferLen = 0;
+  stats = {};
+  running = !chunks.empty();
+}
+
+void TelemetryReplay::wakeup(uint32_t nowMs)
+{
+  if (!running) return;
+
+  uint32_t elapsed = nowMs - startMs;
+  uint32_t first = chunks[0].timeMs;
+  auto t0 = std::chrono::steady_clock::now();
+
+  while (next < chunks.size()) {
+    const Chunk& chunk = chunks[next];
+    uint32_t offset = chunk.timeMs > first ? chunk.timeMs - first : 0;
+    if (speed && offset / speed > elapsed) break;
+    feed(chunk);
+    next++;
+  }
+
+  auto t1 = std::chrono::steady_clock::now();
+  stats.decodeUs +=
+      std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+
+  if (next >= chunks.size()) running = false;
+}
+
+void TelemetryReplay::runAll()
+{
+  if (!running) return;
+  uint16_t saved = speed;
+  speed = 0;
+  wakeup(startMs);
+  speed = saved;
+}
+
+void TelemetryReplay::feed(const Chunk& chunk)
+{
+  const uint8_t* p = &data[chunk.offset];
+  telemetryLinkBegin(module);
+  for (uint32_t i = 0; i < chunk.count; i++) {
+    switch (protocol) {
+      case TELEMETRY_REPLAY_SPORT:
+        feedSport(p[i]);
+        break;
+      case TELEMETRY_REPLAY_CROSSFIRE:
+        feedCrossfire(p[i]);
+        break;
+      case TELEMETRY_REPLAY_GHOST:
+        feedGhost(p[i]);
+        break;
+      default:
+        break;
+    }
+  }
+  telemetryLinkEnd(module);
+  stats.bytes += chunk.count;
+}
+
+void TelemetryReplay::feedSport(uint8_t byte)
+{
+  // the S.Port decoder does its own framing, a frame is complete when the
+  // buffer reaches a full packet
+  uint8_t len = bufferLen;
+  processFrskySportTelemetryData(module, byte, buffer, bufferLen);
+  if (len < FRSKY_SPORT_PACKET_SIZE && bufferLen >= FRSKY_SPORT_PACKET_SIZE) {
+    stats.frames++;
+    if (!checkSportPacket(buffer)) stats.errors++;
+  }
+}
+
+void TelemetryReplay::feedCrossfire(uint8_t byte)
+{
+#if defined(CROSSFIRE)
+  if (bufferLen == 0 && byte != RADIO_ADDRESS && byte != UART_SYNC) return;
+
+  buffer[bufferLen++] = byte;
+  if (bufferLen < 2) return;
+
+  unsigned frameLen = buffer[1] + 2;
+  if (buffer[1] < 2 || frameLen > TELEMETRY_REPLAY_BUFFER_SIZE) {
+    stats.errors++;
+    bufferLen = 0;
+    return;
+  }
+
+  if (bufferLen == frameLen) {
+    stats.frames++;
+    if (crc8(&buffer[2], buffer[1] - 1) == buffer[frameLen - 1])
+      processCrossfireTelemetryFrame(module, buffer, frameLen);
+    else
+      stats.errors++;
+    bufferLen = 0;
+  }
+#endif
+}
+
+void TelemetryReplay::feedGhost(uint8_t byte)
+{
+#if defined(GHOST)
+  if (bufferLen == 0 && byte != GHST_ADDR_RADIO) return;
+
+  buffer[bufferLen++] = byte;
+  if (bufferLen < 2) return;
+
+  unsigned frameLen = buffer[1] + 2;
+  if (buffer[1] < 2 || frameLen > TELEMETRY_REPLAY_BUFFER_SIZE) {
+    stats.errors++;
+    bufferLen = 0;
+    return;
+  }
+
+  if (bufferLen == frameLen) {
+    stats.frames++;
+    if (crc8(&buffer[2], buffer[1] - 1) != buffer[frameLen - 1])
+      stats.errors++;
+    // the decoder checks the CRC again and drops bad frames
+    processGhostTelemetryFrame(module, buffer, frameLen);
+    bufferLen = 0;
+  }
+#endif
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+/*
+  Replays a raw telemetry capture (as written by LOG_TELEMETRY, one
+  "YYYY-MM-DD,HH:MM:SS.mmm:" stamped line of hex bytes per 10ms tick)
+  through the same decoders the module drivers use.
+
+  With speed = 1 the chunks are fed with their original spacing, speed = N
+  plays N times faster and speed = 0 pushes everything as fast as possible,
+  which is what runAll() is for when measuring decoder throughput.
+*/
+
+enum TelemetryReplayProtocol {
+  TELEMETRY_REPLAY_SPORT,
+  TELEMETRY_REPLAY_CROSSFIRE,
+  TELEMETRY_REPLAY_GHOST,
+  TELEMETRY_REPLAY_COUNT
+};
+
+#define TELEMETRY_REPLAY_BUFFER_SIZE  128
+
+struct TelemetryReplayStats {
+  uint32_t bytes;
+  uint32_t frames;
+  uint32_t errors;
+  uint64_t decodeUs;
+
+  uint32_t framesPerSecond() const
+  {
+    return decodeUs ? (uint32_t)((uint64_t)frames * 1000000 / decodeUs) : 0;
+  }
+};
+
+class TelemetryReplay
+{
+ public:
+  bool load(const char* filename);
+  // returns the number of chunks found in the capture
+  uint32_t parse(const char* text, size_t len);
+  void clear();
+
+  void start(uint8_t module, TelemetryReplayProtocol protocol,
+             uint16_t speed, uint32_t nowMs);
+  void stop() { running = false; }
+  bool isRunning() const { return running; }
+
+  // feeds every chunk due at nowMs, to be called periodically
+  void wakeup(uint32_t nowMs);
+  // feeds the rest of the capture at once, timing the decoders
+  void runAll();
+
+  uint32_t chunkCount() const { return chunks.size(); }
+  const TelemetryReplayStats& getStats() const { return stats; }
+
+ protected:
+  struct Chunk {
+    uint32_t timeMs;
+    uint32_t offset;
+    uint32_t count;
+  };
+
+  std::vector<Chunk> chunks;
+  std::vector<uint8_t> data;
+
+  uint8_t module = 0;
+  TelemetryReplayProtocol protocol = TELEMETRY_REPLAY_SPORT;
+  uint16_t speed = 1;
+  uint32_t startMs = 0;
+  uint32_t next = 0;
+  bool running = false;
+
+  uint8_t buffer[TELEMETRY_REPLAY_BUFFER_SIZE];
+  uint8_t bufferLen = 0;
+  TelemetryReplayStats stats = {};
+
+  void feed(const Chunk& chunk);
+  void feedSport(uint8_t byte);
+  void feedCrossfire(uint8_t byte);
+  void feedGhost(uint8_t byte);
+};
+
+extern TelemetryReplay telemetryReplay;
@@ -24,6 +24,7 @@
 
 #include "tasks.h"
 #include "tasks/mixer_task.h"
+#include "hal/storage.h"
 
 #include "watchdog_driver.h"
 
@@ -76,6 +77,13 @@ TASK_FUNCTION(menusTask)
     DEBUG_TIMER_STOP(debugTimerPerMain);
     // TODO remove completely massstorage from sky9x firmware
     uint32_t runtime = ((uint32_t)RTOS_GET_TIME() - start);
+
+    // use the spare time of this low priority task for storage maintenance
+    if (runtime < MENU_TASK_PERIOD_TICKS / 2) {
+      storageIdle();
+      runtime = ((uint32_t)RTOS_GET_TIME() - start);
+    }
+
     // deduct the thread run-time from the wait, if run-time was more than
     // desired period, then skip the wait all together
     if (runtime < MENU_TASK_PERIOD_TICKS) {
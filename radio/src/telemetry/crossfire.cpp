@@ -98,6 +98,11 @@ template <int N>
 bool getCrossfireTelemetryValue(uint8_t index, int32_t& value,
                                 uint8_t* rxBuffer)
 {
+  // the payload ends right before the CRC, at rxBuffer[1] + 1: a short frame
+  // must not pick up whatever the previous one left in the buffer
+  if (index + N > rxBuffer[1] + 1)
+    return false;
+
   bool result = false;
   uint8_t * byte = &rxBuffer[index];
   value = (*byte & 0x80) ? -1 : 0;
@@ -230,7 +235,8 @@ void processCrossfireTelemetryFrame(uint8_t module, uint8_t* rxBuffer,
     case FLIGHT_MODE_ID:
     {
       const CrossfireSensor & sensor = crossfireSensors[FLIGHT_MODE_INDEX];
-      auto textLength = min<int>(16, rxBuffer[1]);
+      // terminate at the CRC at the latest, the text starts at rxBuffer[3]
+      auto textLength = min<int>(16, crsfPayloadLen + 1);
       rxBuffer[textLength] = '\0';
       setTelemetryText(PROTOCOL_TELEMETRY_CROSSFIRE, sensor.id, 0, sensor.subId,
                        (const char *)rxBuffer + 3);
@@ -238,7 +244,8 @@ void processCrossfireTelemetryFrame(uint8_t module, uint8_t* rxBuffer,
     }
 
     case RADIO_ID:
-      if (rxBuffer[3] == 0xEA     // radio address
+      if (crsfPayloadLen > 4
+          && rxBuffer[3] == 0xEA  // radio address
           && rxBuffer[5] == 0x10  // timing correction frame
       ) {
         uint32_t update_interval;
@@ -259,10 +266,8 @@ void processCrossfireTelemetryFrame(uint8_t module, uint8_t* rxBuffer,
 #if defined(LUA)
     default:
       if (luaInputTelemetryFifo && luaInputTelemetryFifo->hasSpace(rxBufferCount - 2)) {
-        for (uint8_t i = 1; i < rxBufferCount - 1; i++) {
-          // destination address and CRC are skipped
-          luaInputTelemetryFifo->push(rxBuffer[i]);
-        }
+        // destination address and CRC are skipped
+        luaInputTelemetryFifo->write(&rxBuffer[1], rxBufferCount - 2);
       }
       break;
 #endif
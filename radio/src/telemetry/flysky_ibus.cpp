@@ -28,6 +28,7 @@
 
 
 #define FLYSKY_TELEMETRY_LENGTH (2+7*4)        // Should it be 2+7*6???
+#define FLYSKY_PACKET_LENGTH    (FLYSKY_TELEMETRY_LENGTH - 1)  // TX_RSSI | sensor ...
 #define ALT_PRECISION 15
 #define R_DIV_G_MUL_10_Q15 (uint64_t)9591506
 #define INV_LOG2_E_Q1DOT31 (uint64_t)0x58b90bfc // Inverse log base 2 of e
@@ -309,6 +310,8 @@ void processFlySkySensor(const uint8_t * packet, uint8_t type)
   uint8_t buffer[8];
   uint16_t id = packet[0];
   const uint8_t instance = packet[1];
+  // AC sensors carry their own size, the composite ones must be long enough
+  const uint8_t size = (type == 0xAC) ? packet[2] : 2;
   int32_t value;
 
   //Load most likely value
@@ -344,7 +347,7 @@ void processFlySkySensor(const uint8_t * packet, uint8_t type)
   else if (id == AFHDS2A_ID_GPS_STATUS) {
     value = value >> 8;
   }
-  else if (id == AFHDS2A_ID_GPS_FULL) {
+  else if (id == AFHDS2A_ID_GPS_FULL && size >= 14) {
     //(AC FRAME)[ID][inst][size][fix][sats][LAT]x4[LON]x4[ALT]x4
     setTelemetryValue(PROTOCOL_TELEMETRY_FLYSKY_IBUS, AFHDS2A_ID_GPS_STATUS, 0, instance, packet[4], UNIT_RAW, 0);
 
@@ -371,7 +374,7 @@ void processFlySkySensor(const uint8_t * packet, uint8_t type)
     setTelemetryValue(PROTOCOL_TELEMETRY_FLYSKY_IBUS, AFHDS2A_ID_GPS_LAT, 0,
                       instance2, value, UNIT_GPS_LONGITUDE, 0);
     return;
-  } else if (id == AFHDS2A_ID_VOLT_FULL) {
+  } else if (id == AFHDS2A_ID_VOLT_FULL && size >= 10) {
     //(AC FRAME)[ID][inst][size][ACC_X]x2[ACC_Y]x2[ACC_Z]x2[ROLL]x2[PITCH]x2[YAW]x2
     for (uint8_t sensorID = AFHDS2A_ID_EXTV; sensorID <= AFHDS2A_ID_RPM; sensorID++) {
       int index = 3 + (sensorID - AFHDS2A_ID_EXTV) * 2;
@@ -382,7 +385,7 @@ void processFlySkySensor(const uint8_t * packet, uint8_t type)
       processFlySkySensor(buffer, 0xAA);
     }
     return;
-  } else if (id == AFHDS2A_ID_ACC_FULL) {
+  } else if (id == AFHDS2A_ID_ACC_FULL && size >= 12) {
     //(AC FRAME)[ID][inst][size]
     for (uint8_t sensorID = AFHDS2A_ID_ACC_X; sensorID <= AFHDS2A_ID_YAW; sensorID++) {
       int index = 3 + (sensorID - AFHDS2A_ID_ACC_X) * 2;
@@ -412,7 +415,7 @@ void processFlySkyPacket(const uint8_t * packet)
 
   const uint8_t * buffer = packet + 1;
   int sensor = 0;
-  while (sensor++ < 7) {
+  while (sensor++ < 7 && buffer + 4 <= packet + FLYSKY_PACKET_LENGTH) {
     if (*buffer == SENSOR_TYPE_END) break;
     processFlySkySensor(buffer, 0xAA);
     buffer += 4;
@@ -428,6 +431,8 @@ void processFlySkyPacketAC(const uint8_t * packet)
   {
     if (*buffer == SENSOR_TYPE_END) break;
     uint8_t size = buffer[2];
+    // the value is always read as 4 bytes
+    if (buffer + 3 + max<uint8_t>(size, 4) > packet + FLYSKY_PACKET_LENGTH) break;
     processFlySkySensor(buffer, 0xAC);
     buffer += size + 3;
   }
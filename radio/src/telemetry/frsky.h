@@ -49,11 +49,31 @@ inline bool IS_HIDDEN_TELEMETRY_VALUE(uint16_t id)
   return (id == SP2UART_A_ID) || (id == SP2UART_B_ID) || (id == XJT_VERSION_ID) || (id == RAS_ID) || (id == FACT_TEST_ID);
 }
 
+// Radio RSSI. Decoders set it while their module stream is decoded (see
+// telemetryLinkBegin()): unless links are shared, the value goes to that
+// link and only the value of the active link is published to the readers.
+class TelemetryRssi: public TelemetryFilterDecorator<TelemetryValue> {
+  public:
+    void set(uint8_t value);
+    void reset();
+
+    // link lost, clears the published value
+    void clear()
+    {
+      TelemetryFilterDecorator<TelemetryValue>::reset();
+    }
+
+    void publish(uint8_t value)
+    {
+      this->_value = value;
+    }
+};
+
 class TelemetryData {
   public:
     TelemetryExpiringDecorator<TelemetryValue> swrInternal;
     TelemetryExpiringDecorator<TelemetryValue> swrExternal;
-    TelemetryFilterDecorator<TelemetryValue> rssi;
+    TelemetryRssi rssi;
     uint16_t xjtVersion;
     uint8_t varioHighPrecision:1;
     uint8_t telemetryValid:3;
@@ -98,6 +118,7 @@ void processHubPacket(uint8_t id, int16_t value);
 void frskyDProcessPacket(uint8_t module, const uint8_t *packet, uint8_t len);
 
 // FrSky S.PORT Telemetry Protocol
+bool checkSportPacket(const uint8_t * packet);
 bool sportProcessTelemetryPacket(uint8_t module, const uint8_t * packet, uint8_t len);
 void sportProcessTelemetryPacket(uint16_t id, uint8_t subId, uint8_t instance,
                                  uint32_t data, TelemetryUnit unit = UNIT_RAW);
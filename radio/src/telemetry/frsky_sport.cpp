@@ -397,9 +397,7 @@ void sportProcessTelemetryPacketWithoutCrc(uint8_t module, uint8_t origin, const
             luaPacket.primId = primId;
             luaPacket.dataId = dataId;
             luaPacket.value = data;
-            for (uint8_t i=0; i<sizeof(SportTelemetryPacket); i++) {
-              luaInputTelemetryFifo->push(luaPacket.raw[i]);
-            }
+            luaInputTelemetryFifo->write(luaPacket.raw, sizeof(luaPacket));
           }
 #endif
         }
@@ -437,9 +435,7 @@ void sportProcessTelemetryPacketWithoutCrc(uint8_t module, uint8_t origin, const
       luaPacket.primId = primId;
       luaPacket.dataId = dataId;
       luaPacket.value = data;
-      for (uint8_t i=0; i<sizeof(SportTelemetryPacket); i++) {
-        luaInputTelemetryFifo->push(luaPacket.raw[i]);
-      }
+      luaInputTelemetryFifo->write(luaPacket.raw, sizeof(luaPacket));
     }
   }
 #endif
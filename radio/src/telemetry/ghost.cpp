@@ -165,12 +165,23 @@ void processGhostTelemetryFrame(uint8_t module, uint8_t* buffer, uint32_t length
 {
   uint8_t frame_len = buffer[1];
   auto frame = buffer + 2;
+  if (frame_len < 2 || frame_len + 2u > length) {
+    TRACE("[GS] length error");
+    return;
+  }
+
   if (!checkGhostTelemetryFrameCRC(frame, frame_len)) {
     TRACE("[GS] CRC error");
     return;
   }
 
   uint8_t id = frame[0];
+  if (id >= GHST_DL_OPENTX_SYNC && id <= GHST_DL_MAGBARO &&
+      frame_len < (id == GHST_DL_MENU_DESC ? sizeof(GhostMenuFrame) - 2
+                                           : GHST_DL_FRAME_SIZE)) {
+    TRACE("[GS] frame 0x%02X too short (%d)", id, frame_len);
+    return;
+  }
   switch(id) {
     case GHST_DL_OPENTX_SYNC:
     {
@@ -249,6 +260,8 @@ void processGhostTelemetryFrame(uint8_t module, uint8_t* buffer, uint32_t length
       GhostMenuFrame * packet;
       GhostMenuData * lineData;
       packet = (GhostMenuFrame * )buffer;
+      if (packet->lineIndex > GHST_MENU_LINES)
+        break;
       lineData = (GhostMenuData *) &reusableBuffer.ghostMenu.line[packet->lineIndex];
       lineData->splitLine = 0;
       reusableBuffer.ghostMenu.menuStatus = packet->menuStatus;
@@ -314,9 +327,7 @@ void processGhostTelemetryFrame(uint8_t module, uint8_t* buffer, uint32_t length
     default:
       // destination address and CRC are skipped
       if (luaInputTelemetryFifo && luaInputTelemetryFifo->hasSpace(length - 2) ) {
-        for (uint8_t i = 1; i < length - 1; i++) {
-          luaInputTelemetryFifo->push(buffer[i]);
-        }
+        luaInputTelemetryFifo->write(&buffer[1], length - 2);
       }
       break;
 #endif
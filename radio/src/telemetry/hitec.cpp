@@ -355,7 +355,8 @@ void processHitecPacket(const uint8_t * packet)
       current_ms = RTOS_GET_MS();
       sensor = getHitecSensor(HITEC_ID_VARIO);
       value = (alt - last_alt) * 100;
-      if ((current_ms - last_ms) < 1000)
+      // two frames within the same ms on a fast link
+      if (current_ms != last_ms && (current_ms - last_ms) < 1000)
         value /= (int32_t) (current_ms - last_ms);
       else
         value = 0;
@@ -317,7 +317,7 @@ int16_t processHoTTdBm(int16_t value)
   return value/2 - 71;
 }
 
-uint8_t processHoTTWarnings(const uint8_t * packet) {
+uint8_t processHoTTWarnings(const uint8_t * packet, uint8_t len) {
   // Translates rx events to warnings and transfers GAM, EAM, GPS, VARIO, ESC warnings
   // 
   // Two types of warnings have to be considered:
@@ -335,7 +335,7 @@ uint8_t processHoTTWarnings(const uint8_t * packet) {
   // For a list of warnings see HoTT_warnings.txt
   //
   // Rx events are passed from MPM in page 0, packet[12]
-  // Other device warnings are passed in packet[14]
+  // Other device warnings are passed in packet[14], when MPM sends it
   // 
   // As only one warning can be transferred to the user the device warnigs are prioritized 
   // by the order RX, ESC, GAM, EAM, VARIO, GPS
@@ -382,7 +382,7 @@ uint8_t processHoTTWarnings(const uint8_t * packet) {
         warnings[HOTT_WARN_RX] = 53;              // other rx events -> translate to general receiver warning
     }  
   } else {
-    if (PAGE > 0 && PAGE <= 4) {                  // sending device is other than rx
+    if (PAGE > 0 && PAGE <= 4 && len > 14) {      // sending device is other than rx
       switch (DEVICE) {
         case HOTT_TELEM_ESC:                      // sending device is ESC
           warnings[HOTT_WARN_ESC] = WARN;
@@ -418,7 +418,7 @@ uint8_t processHoTTWarnings(const uint8_t * packet) {
   return 0;                                       // return 0 (no warning)
 }
 
-void processHottPacket(const uint8_t * packet)
+void processHottPacket(const uint8_t * packet, uint8_t len)
 {
   #if defined(LUA)
   #define HOTT_MENU_NBR_PAGE 0x13
@@ -459,7 +459,7 @@ void processHottPacket(const uint8_t * packet)
   int16_t deg = 0, sec = 0;
 
   // Set RX Event (HoTT warnings) 
-  value = processHoTTWarnings(packet);
+  value = processHoTTWarnings(packet, len);
   sensor = getHottSensor(HOTT_ID_RX_EVENT);
   setTelemetryValue(PROTOCOL_TELEMETRY_HOTT, HOTT_ID_RX_EVENT, 0, 0, value, sensor->unit, sensor->precision);
 
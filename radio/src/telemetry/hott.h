@@ -25,6 +25,6 @@
 void hottSetDefault(int index, uint16_t id, uint8_t subId, uint8_t instance);
 
 // Used by multi protocol
-void processHottPacket(const uint8_t * packet);
+void processHottPacket(const uint8_t * packet, uint8_t len);
 
 #endif
@@ -386,17 +386,17 @@ static void processMultiTelemetryPaket(const uint8_t * packet, uint8_t module)
       break;
 
     case FlyskyIBusTelemetry:
-      if (len >= 28)
+      if (len >= 29)
         processFlySkyPacket(data);
       else
-        TRACE("[MP] Received IBUS telemetry len %d < 28", len);
+        TRACE("[MP] Received IBUS telemetry len %d < 29", len);
       break;
 
     case FlyskyIBusTelemetryAC:
-      if (len >= 28)
+      if (len >= 29)
         processFlySkyPacketAC(data);
       else
-        TRACE("[MP] Received IBUS telemetry AC len %d < 28", len);
+        TRACE("[MP] Received IBUS telemetry AC len %d < 29", len);
       break;
 
     case HitecTelemetry:
@@ -408,16 +408,17 @@ static void processMultiTelemetryPaket(const uint8_t * packet, uint8_t module)
 
     case HottTelemetry:
       if (len >= 14)
-        processHottPacket(data);
+        processHottPacket(data, len);
       else
         TRACE("[MP] Received HoTT telemetry len %d < 14", len);
       break;
 
     case MLinkTelemetry:
-      if (len > 6)
+      // RSSI, LQI and a 7 bytes M-Link packet (type + 2 sensors)
+      if (len >= 9)
         processMLinkPacket(data, true);
       else
-        TRACE("[MP] Received M-Link telemetry len %d <= 6", len);
+        TRACE("[MP] Received M-Link telemetry len %d < 9", len);
       break;
 
 #if defined(LUA)
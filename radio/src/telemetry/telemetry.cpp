@@ -60,6 +60,10 @@
   #include "flysky_ibus.h"
 #endif
 
+#if defined(LUA)
+  #include "telemetry_history.h"
+#endif
+
 uint8_t telemetryStreaming = 0;
 uint8_t telemetryRxBuffer[TELEMETRY_RX_PACKET_SIZE];
 uint8_t telemetryRxBufferCount = 0;
@@ -68,6 +72,16 @@ uint8_t telemetryState = TELEMETRY_INIT;
 
 TelemetryData telemetryData;
 
+int8_t telemetryDecodingModule = -1;
+
+struct TelemetryLink {
+  TelemetryFilterDecorator<TelemetryValue> rssi;
+  uint8_t streaming;
+};
+
+static TelemetryLink telemetryLinks[MAX_MODULES];
+static uint8_t _telemetryActiveLink = INTERNAL_MODULE;
+
 #if defined(INTERNAL_MODULE_SERIAL_TELEMETRY)
 static uint8_t intTelemetryRxBuffer[TELEMETRY_RX_PACKET_SIZE];
 static uint8_t intTelemetryRxBufferCount;
@@ -195,7 +209,7 @@ void telemetryStart()
 {
   if (!telemetryTimer) {
     telemetryTimer =
-        xTimerCreateStatic("Telem", 2 / RTOS_MS_PER_TICK, pdTRUE, (void*)0,
+        xTimerCreateStatic("Telem", TELEMETRY_POLL_PERIOD_MS / RTOS_MS_PER_TICK, pdTRUE, (void*)0,
                            telemetryTimerCb, &telemetryTimerBuffer);
   }
 
@@ -247,7 +261,9 @@ static void _poll_frame(void *pvParameter1, uint32_t ulParameter2)
 
     uint8_t* rxBuffer = getTelemetryRxBuffer(module);
     uint8_t& rxBufferCount = getTelemetryRxBufferCount(module);
+    telemetryLinkBegin(module);
     drv->processFrame(ctx, frame, frame_len, rxBuffer, &rxBufferCount);
+    telemetryLinkEnd(module);
   }
 
   _telemetryIsPolling = false;
@@ -277,6 +293,18 @@ inline bool isBadAntennaDetected()
   return false;
 }
 
+static uint32_t pollBudget(const etx_serial_driver_t* serial_drv, void* serial_ctx)
+{
+  uint32_t budget = TELEMETRY_POLL_BUDGET;
+  if (serial_drv->getBaudrate) {
+    // 10 bits per byte (start + 8 + stop)
+    uint32_t bytesPerPeriod = serial_drv->getBaudrate(serial_ctx) / 10 *
+                              TELEMETRY_POLL_PERIOD_MS / 1000;
+    budget = max<uint32_t>(budget, bytesPerPeriod * TELEMETRY_POLL_BUDGET_PERIODS);
+  }
+  return budget;
+}
+
 static inline void pollTelemetry(uint8_t module, const etx_proto_driver_t* drv, void* ctx)
 {
   if (!drv || !drv->processData) return;
@@ -293,17 +321,111 @@ static inline void pollTelemetry(uint8_t module, const etx_proto_driver_t* drv,
 
   uint8_t data;
   if (serial_drv->getByte(serial_ctx, &data) > 0) {
+    uint32_t budget = pollBudget(serial_drv, serial_ctx);
+    telemetryLinkBegin(module);
     LOG_TELEMETRY_WRITE_START();
     do {
       telemetryMirrorSend(data);
       drv->processData(ctx, data, rxBuffer, &rxBufferCount);
       LOG_TELEMETRY_WRITE_BYTE(data);
-    } while (serial_drv->getByte(serial_ctx, &data) > 0);
+    } while (--budget > 0 && serial_drv->getByte(serial_ctx, &data) > 0);
+    telemetryLinkEnd(module);
+  }
+}
+
+void telemetryLinkBegin(uint8_t module)
+{
+  telemetryDecodingModule = module;
+}
+
+void telemetryLinkEnd(uint8_t module)
+{
+  telemetryDecodingModule = -1;
+}
+
+static void telemetryPublishRssi()
+{
+  // the radio RSSI (alarms, RSSI source) follows the active link
+  telemetryData.rssi.publish(telemetryLinks[_telemetryActiveLink].rssi.value());
+}
+
+void TelemetryRssi::set(uint8_t value)
+{
+  int8_t module = telemetryDecodingModule;
+  if (g_model.telemetryLinkMode == TELEM_LINKS_SHARED || module < 0) {
+    TelemetryFilterDecorator<TelemetryValue>::set(value);
+    return;
   }
+
+  telemetryLinks[module].rssi.set(value);
+  telemetryPublishRssi();
+}
+
+void TelemetryRssi::reset()
+{
+  int8_t module = telemetryDecodingModule;
+  if (g_model.telemetryLinkMode == TELEM_LINKS_SHARED || module < 0) {
+    TelemetryFilterDecorator<TelemetryValue>::reset();
+    return;
+  }
+
+  telemetryLinks[module].rssi.reset();
+  telemetryPublishRssi();
+}
+
+bool telemetryLinkValue(uint8_t module)
+{
+  telemetryLinks[module].streaming = TELEMETRY_TIMEOUT10ms;
+
+  switch (g_model.telemetryLinkMode) {
+    case TELEM_LINKS_BEST_RSSI:
+    case TELEM_LINKS_FAILOVER:
+      return module == _telemetryActiveLink;
+    default:
+      return true;
+  }
+}
+
+void telemetrySelectLink()
+{
+  uint8_t active = _telemetryActiveLink;
+
+  if (g_model.telemetryLinkMode == TELEM_LINKS_BEST_RSSI) {
+    for (uint8_t i = 0; i < MAX_MODULES; i++) {
+      TelemetryLink & link = telemetryLinks[i];
+      if (i == active || !link.streaming)
+        continue;
+      if (!telemetryLinks[active].streaming ||
+          link.rssi.value() > telemetryLinks[active].rssi.value() + TELEMETRY_LINK_RSSI_HYSTERESIS)
+        active = i;
+    }
+  }
+  else {
+    // failover: the first module still streaming, by module order
+    for (uint8_t i = 0; i < MAX_MODULES; i++) {
+      if (telemetryLinks[i].streaming) {
+        active = i;
+        break;
+      }
+    }
+  }
+
+  if (active != _telemetryActiveLink) {
+    _telemetryActiveLink = active;
+    if (g_model.telemetryLinkMode != TELEM_LINKS_SHARED)
+      telemetryPublishRssi();
+  }
+}
+
+uint8_t telemetryActiveLink()
+{
+  return _telemetryActiveLink;
 }
 
 void telemetryWakeup()
 {
+  telemetrySelectLink();
+
   _telemetryIsPolling = true;
   for (uint8_t i = 0; i < MAX_MODULES; i++) {
     auto mod = pulsesGetModuleDriver(i);
@@ -312,12 +434,7 @@ void telemetryWakeup()
   }
   _telemetryIsPolling = false;
 
-  for (int i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
-    const TelemetrySensor& sensor = g_model.telemetrySensors[i];
-    if (sensor.type == TELEM_TYPE_CALCULATED) {
-      telemetryItems[i].eval(sensor);
-    }
-  }
+  evalCalculatedSensors();
 
 #if defined(VARIO)
   if (TELEMETRY_STREAMING() && !IS_FAI_ENABLED()) {
@@ -403,6 +520,14 @@ void telemetryWakeup()
 
 void telemetryInterrupt10ms()
 {
+  for (auto & link : telemetryLinks) {
+    if (link.streaming > 0 && --link.streaming == 0) {
+      link.rssi.reset();
+      if (g_model.telemetryLinkMode != TELEM_LINKS_SHARED)
+        telemetryPublishRssi();
+    }
+  }
+
   if (telemetryStreaming > 0) {
     bool tick160ms = (telemetryStreaming & 0x0F) == 0;
     for (int i=0; i<MAX_TELEMETRY_SENSORS; i++) {
@@ -418,7 +543,7 @@ void telemetryInterrupt10ms()
   }
   else {
 #if !defined(SIMU)
-    telemetryData.rssi.reset();
+    telemetryData.rssi.clear();
 #endif
     for (auto & telemetryItem: telemetryItems) {
       if (telemetryItem.isAvailable()) {
@@ -438,6 +563,13 @@ void telemetryReset()
 
   telemetryStreaming = 0; // reset counter only if valid telemetry packets are being detected
   telemetryState = TELEMETRY_INIT;
+
+  memclear(telemetryLinks, sizeof(telemetryLinks));
+  _telemetryActiveLink = INTERNAL_MODULE;
+
+#if defined(LUA)
+  telemetryHistory.clear();
+#endif
 }
 
 #if defined(LOG_TELEMETRY) && !defined(SIMU)
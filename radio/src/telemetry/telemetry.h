@@ -57,6 +57,17 @@ constexpr uint8_t TELEMETRY_TIMEOUT10ms = 100; // 1 second
 #define TELEMETRY_RX_PACKET_SIZE       19  // 9 bytes (full packet), worst case 18 bytes with byte-stuffing (+1)
 #endif
 
+#define TELEMETRY_POLL_PERIOD_MS       2
+
+// Bytes decoded per module and per wakeup: what the link delivers in a few
+// poll periods, so that a late wakeup still drains the module FIFO. The
+// rest stays in the FIFO so that a chatty link cannot delay the other one.
+#define TELEMETRY_POLL_BUDGET          (2 * TELEMETRY_RX_PACKET_SIZE)
+#define TELEMETRY_POLL_BUDGET_PERIODS  4
+
+// RSSI difference needed to switch links in TELEM_LINKS_BEST_RSSI mode
+#define TELEMETRY_LINK_RSSI_HYSTERESIS 5
+
 //TODO: remove this public definition
 extern uint8_t telemetryRxBuffer[TELEMETRY_RX_PACKET_SIZE];
 extern uint8_t telemetryRxBufferCount;
@@ -87,6 +98,21 @@ struct etx_proto_driver_t;
 // processing for that module.
 void telemetryFrameTrigger_ISR(uint8_t module, const etx_proto_driver_t* drv);
 
+// Module whose telemetry stream is being decoded, -1 otherwise
+extern int8_t telemetryDecodingModule;
+
+// Bracket the decoding of a module stream, so that values and RSSI
+// are attributed to that module (see TelemetryLinkMode)
+void telemetryLinkBegin(uint8_t module);
+void telemetryLinkEnd(uint8_t module);
+
+// Called for every value decoded from a module stream,
+// returns false if the value must be dropped
+bool telemetryLinkValue(uint8_t module);
+
+void telemetrySelectLink();
+uint8_t telemetryActiveLink();
+
 #define TELEMETRY_AVERAGE_COUNT        3
 
 enum {
@@ -0,0 +1,272 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <stdlib.h>
+#include "telemetry_history.h"
+
+TelemetryHistory telemetryHistory;
+
+void TelemetryHistory::Slot::clear()
+{
+  shift = 0;
+  head = 0;
+  count = 0;
+}
+
+void TelemetryHistory::Slot::release()
+{
+  free(samples);
+  samples = nullptr;
+  sensor = 0;
+}
+
+int16_t TelemetryHistory::Slot::pack(int32_t value)
+{
+  while ((value >> shift) > INT16_MAX || (value >> shift) < INT16_MIN) {
+    for (uint16_t i = 0; i < depth; i++) {
+      samples[i] >>= 1;
+    }
+    shift++;
+  }
+  return value >> shift;
+}
+
+void TelemetryHistory::Slot::append(int32_t value)
+{
+  samples[head] = pack(value);
+  head = (head + 1) % depth;
+  if (count < depth) {
+    count++;
+  }
+}
+
+void TelemetryHistory::Slot::fill(tmr10ms_t now)
+{
+  tmr10ms_t elapsed = now - lastTime;
+  if (count == 0 || elapsed < period) {
+    return;
+  }
+
+  uint32_t periods = elapsed / period;
+  lastTime += periods * period;
+
+  // the sensor was silent, hold its last value up to the current period
+  int32_t last = at(count - 1);
+  for (uint32_t i = 0; i < periods && i < depth; i++) {
+    append(last);
+  }
+}
+
+void TelemetryHistory::Slot::push(int32_t value, tmr10ms_t now)
+{
+  if (count == 0) {
+    lastTime = now;
+    append(value);
+    return;
+  }
+
+  // the newest sample is the one of the current period
+  fill(now);
+  samples[(head + depth - 1) % depth] = pack(value);
+}
+
+int16_t TelemetryHistory::Slot::packedAt(uint16_t i) const
+{
+  return samples[(head + depth - count + i) % depth];
+}
+
+int32_t TelemetryHistory::Slot::at(uint16_t i) const
+{
+  return packedAt(i) * (1 << shift);
+}
+
+TelemetryHistory::Slot * TelemetryHistory::find(uint8_t sensor)
+{
+  for (auto & slot : slots) {
+    if (slot.sensor == sensor + 1) {
+      return &slot;
+    }
+  }
+  return nullptr;
+}
+
+// push() runs in the telemetry timer callback, which must not block: it
+// only tries to take the mutex. The other accesses are done by Lua and the
+// UI, which hold it for one pass over a slot at most.
+
+TelemetryHistory::TelemetryHistory()
+{
+  RTOS_CREATE_MUTEX(mutex);
+}
+
+TelemetryHistory::~TelemetryHistory()
+{
+  reset();
+}
+
+bool TelemetryHistory::start(uint8_t sensor, uint16_t depth, uint8_t period)
+{
+  if (depth == 0) {
+    stop(sensor);
+    return false;
+  }
+
+  if (depth > TELEMETRY_HISTORY_DEPTH) {
+    depth = TELEMETRY_HISTORY_DEPTH;
+  }
+  if (period == 0) {
+    period = 1;
+  }
+
+  RTOS_LOCK_MUTEX(mutex);
+
+  Slot * slot = find(sensor);
+  if (!slot) {
+    for (auto & unused : slots) {
+      if (unused.sensor == 0) {
+        slot = &unused;
+        active++;
+        break;
+      }
+    }
+  }
+
+  if (slot && (slot->sensor == 0 || slot->depth != depth || slot->period != period)) {
+    free(slot->samples);
+    slot->samples = (int16_t *)malloc(depth * sizeof(int16_t));
+    if (slot->samples) {
+      slot->depth = depth;
+      slot->period = period;
+      slot->clear();
+      slot->sensor = sensor + 1;
+    }
+    else {
+      slot->release();
+      active--;
+      slot = nullptr;
+    }
+  }
+
+  RTOS_UNLOCK_MUTEX(mutex);
+
+  return slot != nullptr;
+}
+
+void TelemetryHistory::stop(uint8_t sensor)
+{
+  RTOS_LOCK_MUTEX(mutex);
+  Slot * slot = find(sensor);
+  if (slot) {
+    slot->release();
+    active--;
+  }
+  RTOS_UNLOCK_MUTEX(mutex);
+}
+
+void TelemetryHistory::reset()
+{
+  RTOS_LOCK_MUTEX(mutex);
+  for (auto & slot : slots) {
+    slot.release();
+  }
+  active = 0;
+  RTOS_UNLOCK_MUTEX(mutex);
+}
+
+void TelemetryHistory::clear()
+{
+  RTOS_LOCK_MUTEX(mutex);
+  for (auto & slot : slots) {
+    slot.clear();
+  }
+  RTOS_UNLOCK_MUTEX(mutex);
+}
+
+void TelemetryHistory::push(int sensor, int32_t value, tmr10ms_t now)
+{
+  if (!active) {
+    return;
+  }
+
+  // a value received while a script copies the history is dropped, the
+  // sample of the current period keeps the previous one
+  if (!RTOS_TRYLOCK_MUTEX(mutex)) {
+    return;
+  }
+
+  Slot * slot = find(sensor);
+  if (slot) {
+    slot->push(value, now);
+  }
+  RTOS_UNLOCK_MUTEX(mutex);
+}
+
+int TelemetryHistory::size(uint8_t sensor)
+{
+  RTOS_LOCK_MUTEX(mutex);
+  Slot * slot = find(sensor);
+  int result = slot ? slot->count : -1;
+  RTOS_UNLOCK_MUTEX(mutex);
+  return result;
+}
+
+int TelemetryHistory::read(uint8_t sensor, tmr10ms_t now, uint16_t count,
+                           uint16_t points, int32_t * values)
+{
+  RTOS_LOCK_MUTEX(mutex);
+
+  Slot * slot = find(sensor);
+  if (!slot) {
+    RTOS_UNLOCK_MUTEX(mutex);
+    return -1;
+  }
+
+  slot->fill(now);
+  if (count > slot->count) {
+    count = slot->count;
+  }
+  uint16_t first = slot->count - count;
+
+  if (points == 0 || points >= count) {
+    for (uint16_t i = 0; i < count; i++) {
+      values[i] = slot->at(first + i);
+    }
+  }
+  else {
+    // work on packed values, unpack the results only
+    for (uint16_t group = 0; group < points; group++) {
+      uint16_t from = first + group * count / points;
+      uint16_t to = first + (group + 1) * count / points;
+      int16_t lo = INT16_MAX, hi = INT16_MIN;
+      for (uint16_t i = from; i < to; i++) {
+        int16_t sample = slot->packedAt(i);
+        if (sample < lo) lo = sample;
+        if (sample > hi) hi = sample;
+      }
+      values[2 * group] = lo * (1 << slot->shift);
+      values[2 * group + 1] = hi * (1 << slot->shift);
+    }
+  }
+
+  RTOS_UNLOCK_MUTEX(mutex);
+
+  return count;
+}
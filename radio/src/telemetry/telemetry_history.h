@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _TELEMETRY_HISTORY_H_
+#define _TELEMETRY_HISTORY_H_
+
+#include <inttypes.h>
+#include "rtos.h"
+#include "timers_driver.h"
+
+#if defined(COLORLCD)
+  #define TELEMETRY_HISTORY_SLOTS        8
+  #define TELEMETRY_HISTORY_DEPTH        480  // one sample per pixel across the screen
+#else
+  #define TELEMETRY_HISTORY_SLOTS        4
+  #define TELEMETRY_HISTORY_DEPTH        128
+#endif
+
+#define TELEMETRY_HISTORY_DEFAULT_PERIOD 10   // 100ms
+
+// Sampled history of a few telemetry sensors, fed from TelemetryItem::setValue().
+//
+// Each sensor gets a slot with a fixed sampling period: a sample holds the last
+// value received during its period, and the last value is repeated when the
+// sensor is silent for several periods. Samples are packed as int16_t, values
+// which do not fit shift the whole slot right, so only the low bits are lost.
+// The samples of a slot are only allocated once its history is started.
+class TelemetryHistory {
+  public:
+    TelemetryHistory();
+    ~TelemetryHistory();
+
+    // Start (or reconfigure) the history of a sensor, false if no slot is free
+    bool start(uint8_t sensor, uint16_t depth, uint8_t period);
+    void stop(uint8_t sensor);
+
+    // Release all slots
+    void reset();
+
+    // Drop the samples, keep the slots
+    void clear();
+
+    void push(int sensor, int32_t value, tmr10ms_t now);
+
+    // Number of samples recorded for a sensor, -1 if it has no history
+    int size(uint8_t sensor);
+
+    // Copy the last count samples of a sensor, from the oldest one, after
+    // holding its last value up to now. When 0 < points < samples read, the
+    // samples are split in points groups and the min and max of each group
+    // are copied instead, as pairs. values must hold count values, or
+    // 2 * points when points < count.
+    // Returns the number of samples read, -1 if the sensor has no history
+    int read(uint8_t sensor, tmr10ms_t now, uint16_t count, uint16_t points,
+             int32_t * values);
+
+  protected:
+    struct Slot {
+      uint8_t sensor;  // sensor index + 1, 0 if free
+      uint8_t period;  // 10ms units
+      uint8_t shift;
+      uint16_t depth;
+      uint16_t head;   // next write position
+      uint16_t count;
+      tmr10ms_t lastTime;
+      int16_t * samples;
+
+      void clear();
+      void fill(tmr10ms_t now);
+      void push(int32_t value, tmr10ms_t now);
+      void append(int32_t value);
+      int16_t pack(int32_t value);
+      int16_t packedAt(uint16_t i) const;
+      int32_t at(uint16_t i) const;
+      void release();
+    };
+
+    RTOS_MUTEX_HANDLE mutex;
+    Slot slots[TELEMETRY_HISTORY_SLOTS] = {};
+    uint8_t active = 0;
+
+    Slot * find(uint8_t sensor);
+};
+
+extern TelemetryHistory telemetryHistory;
+
+#endif // _TELEMETRY_HISTORY_H_
@@ -55,6 +55,10 @@
   #include "flysky_ibus.h"
 #endif
 
+#if defined(LUA)
+  #include "telemetry_history.h"
+#endif
+
 TelemetryItem telemetryItems[MAX_TELEMETRY_SENSORS];
 uint8_t allowNewSensors;
 
@@ -118,6 +122,7 @@ void TelemetryItem::setValue(const TelemetrySensor &sensor, int32_t val,
       cells.count = cellsCount;
     }
     cells.values[cellIndex].set(cellValue);
+    generation++;
     if (cellIndex+1 == cells.count) {
       newVal = 0;
       for (int i=0; i<cellsCount; i++) {
@@ -273,6 +278,10 @@ void TelemetryItem::setValue(const TelemetrySensor &sensor, int32_t val,
     }
   }
 
+#if defined(LUA)
+  telemetryHistory.push(&sensor - g_model.telemetrySensors, newVal, get_tmr10ms());
+#endif
+
   value = newVal;
   setFresh();
 }
@@ -473,10 +482,111 @@ void TelemetryItem::eval(const TelemetrySensor & sensor)
   }
 }
 
+// Sources used by TelemetryItem::eval(), as sensor index + 1 (0 = none)
+static uint8_t getCalculatedSources(const TelemetrySensor & sensor, uint8_t * sources)
+{
+  switch (sensor.formula) {
+    case TELEM_FORMULA_CELL:
+      sources[0] = sensor.cell.source;
+      return 1;
+
+    case TELEM_FORMULA_DIST:
+      sources[0] = sensor.dist.gps;
+      sources[1] = sensor.dist.alt;
+      return 2;
+
+    case TELEM_FORMULA_ADD:
+    case TELEM_FORMULA_AVERAGE:
+    case TELEM_FORMULA_MIN:
+    case TELEM_FORMULA_MAX:
+    case TELEM_FORMULA_MULTIPLY:
+      for (int i = 0; i < 4; i++) {
+        sources[i] = abs(sensor.calc.sources[i]);
+      }
+      return 4;
+
+    default:
+      // consumption and totalize are updated from per10ms() and setValue()
+      return 0;
+  }
+}
+
+// Generation of each item seen by the last evaluation. Items are updated
+// from the telemetry ISR and from Lua while the sensors are evaluated, so
+// each call only consumes the generations it read: an update landing
+// during the pass is picked up by the next call.
+static uint8_t evaluatedGeneration[MAX_TELEMETRY_SENSORS];
+
+void evalCalculatedSensors()
+{
+  enum { CALC_NONE, CALC_PENDING, CALC_DONE };
+  uint8_t state[MAX_TELEMETRY_SENSORS];
+  uint8_t generation[MAX_TELEMETRY_SENSORS];
+  uint8_t pending = 0;
+
+  for (int i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
+    generation[i] = telemetryItems[i].generation;
+    const TelemetrySensor & sensor = g_model.telemetrySensors[i];
+    uint8_t sources[4];
+    if (sensor.type == TELEM_TYPE_CALCULATED && getCalculatedSources(sensor, sources)) {
+      state[i] = CALC_PENDING;
+      pending++;
+    }
+    else {
+      state[i] = CALC_NONE;
+    }
+  }
+
+  // Each pass evaluates the sensors whose calculated sources are done,
+  // a sensor is only evaluated if one of its sources changed
+  bool cycle = false;
+  while (pending > 0) {
+    uint8_t evaluated = 0;
+    for (int i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
+      if (state[i] != CALC_PENDING)
+        continue;
+
+      const TelemetrySensor & sensor = g_model.telemetrySensors[i];
+      uint8_t sources[4];
+      uint8_t count = getCalculatedSources(sensor, sources);
+      bool ready = true, changed = false;
+      for (uint8_t j = 0; j < count; j++) {
+        uint8_t source = sources[j];
+        if (source == 0 || source > MAX_TELEMETRY_SENSORS)
+          continue;
+        if (state[source - 1] == CALC_PENDING && source - 1 != i)
+          ready = false;
+        if (generation[source - 1] != evaluatedGeneration[source - 1])
+          changed = true;
+      }
+
+      // sensors depending on each other are evaluated in index order
+      if (!ready && !cycle)
+        continue;
+
+      if (changed) {
+        telemetryItems[i].eval(sensor);
+        // sensors depending on this one see the new value in this call
+        generation[i] = telemetryItems[i].generation;
+      }
+      state[i] = CALC_DONE;
+      evaluated++;
+    }
+
+    pending -= evaluated;
+    cycle = (evaluated == 0);
+  }
+
+  memcpy(evaluatedGeneration, generation, sizeof(evaluatedGeneration));
+}
+
 void delTelemetryIndex(uint8_t index)
 {
   memclear(&g_model.telemetrySensors[index], sizeof(TelemetrySensor));
   telemetryItems[index].clear();
+#if defined(LUA)
+  telemetryHistory.stop(index);
+#endif
   storageDirty(EE_MODEL);
 }
 
@@ -509,11 +619,22 @@ int setTelemetryValue(TelemetryProtocol protocol, uint16_t id, uint8_t subId,
 {
   bool sensorFound = false;
 
+  // values pushed by Lua scripts do not belong to any module stream
+  int8_t module = protocol == PROTOCOL_TELEMETRY_LUA ? -1 : telemetryDecodingModule;
+  if (module >= 0 && !telemetryLinkValue(module)) {
+    return -1;
+  }
+
+  // in separate mode each module only sees the sensors it discovered
+  bool separate =
+      module >= 0 && g_model.telemetryLinkMode == TELEM_LINKS_SEPARATE;
+
   for (int index = 0; index < MAX_TELEMETRY_SENSORS; index++) {
     TelemetrySensor &telemetrySensor = g_model.telemetrySensors[index];
 
     if (telemetrySensor.type == TELEM_TYPE_CUSTOM && telemetrySensor.id == id &&
         telemetrySensor.subId == subId &&
+        (!separate || telemetrySensor.module == module) &&
         (telemetrySensor.isSameInstance(protocol, instance) ||
          g_model.ignoreSensorIds)) {
 
@@ -593,6 +714,9 @@ int setTelemetryValue(TelemetryProtocol protocol, uint16_t id, uint8_t subId,
       default:
         return index;
     }
+    if (separate) {
+      g_model.telemetrySensors[index].module = module;
+    }
     telemetryItems[index].setValue(g_model.telemetrySensors[index], value, unit, prec);
     return index;
   }
@@ -48,6 +48,7 @@ class TelemetryItem
     };
 
     int8_t timeout; // for detection of sensor loss
+    uint8_t generation; // incremented on each update, see evalCalculatedSensors()
 
     union {
       struct {
@@ -125,15 +126,23 @@ class TelemetryItem
     inline void setFresh()
     {
       timeout = TELEMETRY_SENSOR_TIMEOUT_START;
+      generation++;
     }
 
     inline void setOld()
     {
-      timeout = TELEMETRY_SENSOR_TIMEOUT_OLD;
+      if (timeout != TELEMETRY_SENSOR_TIMEOUT_OLD) {
+        timeout = TELEMETRY_SENSOR_TIMEOUT_OLD;
+        generation++;
+      }
     }
 };
 
 extern TelemetryItem telemetryItems[MAX_TELEMETRY_SENSORS];
+
+// Evaluate the calculated sensors whose sources changed since the last call,
+// sources first so that chained sensors are consistent after one call
+void evalCalculatedSensors();
 extern uint8_t allowNewSensors;
 bool isFaiForbidden(source_t idx);
 
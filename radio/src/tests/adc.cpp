@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "gtests.h"
+#include "hal/adc_driver.h"
+#include "tasks/mixer_task.h"
+
+extern const etx_hal_adc_driver_t simu_adc_driver;
+
+// Driver converting in the background: a started conversion only updates
+// the values once completed, like the DMA interrupt of the real drivers
+static uint16_t fakeNextValue;
+static uint16_t fakeConversions;
+static bool fakePending;
+
+static void fakeCompleteConversion()
+{
+  if (!fakePending) return;
+  adcValuesWriteBegin();
+  for (uint8_t i = 0; i < adcGetInputOffset(ADC_INPUT_VBAT); i++)
+    setAnalogValue(i, fakeNextValue);
+  adcValuesWriteEnd();
+  fakePending = false;
+}
+
+static bool fakeStartConversion()
+{
+  fakeConversions++;
+  fakePending = true;
+  return true;
+}
+
+static bool fakeCheckCompletion()
+{
+  return !fakePending;
+}
+
+class AdcTest : public testing::Test
+{
+ protected:
+  etx_hal_adc_driver_t driver;
+
+  void SetUp() override
+  {
+    driver = simu_adc_driver;
+    driver.start_conversion = fakeStartConversion;
+    driver.wait_completion = fakeCompleteConversion;
+    driver.check_completion = fakeCheckCompletion;
+    fakeConversions = 0;
+    fakePending = false;
+    adcInit(&driver);
+  }
+
+  void TearDown() override
+  {
+    mixerTaskStop();
+    adcRead();
+    adcInit(&simu_adc_driver);
+  }
+};
+
+TEST_F(AdcTest, blockingReadOutsideMixer)
+{
+  fakeNextValue = 100;
+  EXPECT_TRUE(adcRead());
+  EXPECT_EQ(fakeConversions, 1);
+  EXPECT_EQ(getAnalogValue(0), 100);
+
+  fakeNextValue = 200;
+  EXPECT_TRUE(adcRead());
+  EXPECT_EQ(fakeConversions, 2);
+  EXPECT_EQ(getAnalogValue(0), 200);
+}
+
+TEST_F(AdcTest, staleSnapshotInMixer)
+{
+  // a first blocking conversion, before the mixer runs
+  fakeNextValue = 100;
+  adcRead();
+  mixerTaskStart();
+
+  // the next conversion starts in the background: the last values are kept
+  fakeNextValue = 200;
+  EXPECT_TRUE(adcRead());
+  EXPECT_EQ(fakeConversions, 2);
+  EXPECT_EQ(getAnalogValue(0), 100);
+
+  // still converting: no new conversion, same values
+  EXPECT_TRUE(adcRead());
+  EXPECT_EQ(fakeConversions, 2);
+  EXPECT_EQ(getAnalogValue(0), 100);
+
+  // completed: its values are used and the next conversion starts
+  fakeCompleteConversion();
+  fakeNextValue = 300;
+  EXPECT_TRUE(adcRead());
+  EXPECT_EQ(fakeConversions, 3);
+  EXPECT_EQ(getAnalogValue(0), 200);
+
+  // one-shot reads outside the mixer wait for a fresh conversion
+  mixerTaskStop();
+  fakeNextValue = 400;
+  EXPECT_TRUE(adcRead());
+  EXPECT_FALSE(fakePending);
+  EXPECT_EQ(fakeConversions, 4);
+  EXPECT_EQ(getAnalogValue(0), 400);
+}
+
+TEST_F(AdcTest, getValuesCopy)
+{
+  uint16_t values[MAX_ANALOG_INPUTS];
+
+  fakeNextValue = 100;
+  adcRead();
+  adcGetValues(values);
+  EXPECT_EQ(values[0], 100);
+  EXPECT_EQ(values[adcGetInputOffset(ADC_INPUT_VBAT) - 1], 100);
+
+  // the copy is not changed by the next conversion
+  mixerTaskStart();
+  fakeNextValue = 200;
+  adcRead();
+  fakeCompleteConversion();
+  EXPECT_EQ(values[0], 100);
+  adcGetValues(values);
+  EXPECT_EQ(values[0], 200);
+
+  // an update in progress does not block the reader, which gets the
+  // values as they are
+  adcValuesWriteBegin();
+  setAnalogValue(0, 300);
+  adcGetValues(values);
+  EXPECT_EQ(values[0], 300);
+  EXPECT_EQ(values[1], 200);
+  adcValuesWriteEnd();
+}
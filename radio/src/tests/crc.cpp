@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include <chrono>
+#include "gtests.h"
+
+static const uint8_t CHECK_STRING[] = "123456789";
+#define CHECK_LEN (sizeof(CHECK_STRING) - 1)
+
+// bit-wise reference implementation, independent from the tables
+static uint16_t crc16Reference(uint16_t poly, const uint8_t * buf, uint32_t len, uint16_t crc)
+{
+  while (len--) {
+    crc ^= *buf++ << 8;
+    for (int i = 0; i < 8; i++)
+      crc = (crc & 0x8000) ? (crc << 1) ^ poly : (crc << 1);
+  }
+  return crc;
+}
+
+TEST(Crc, knownAnswers)
+{
+  EXPECT_EQ(0x31C3, crc16(CRC_1021, CHECK_STRING, CHECK_LEN));          // CRC-16/XMODEM
+  EXPECT_EQ(0x29B1, crc16(CRC_1021, CHECK_STRING, CHECK_LEN, 0xFFFF));  // CRC-16/CCITT-FALSE
+  EXPECT_EQ(0x604A, crc16(CRC_1189, CHECK_STRING, CHECK_LEN));           // PXX1
+  EXPECT_EQ(0xBC, crc8(CHECK_STRING, CHECK_LEN));                       // CRC-8/DVB-S2
+  EXPECT_EQ(0x20, crc8_BA(CHECK_STRING, CHECK_LEN));
+}
+
+TEST(Crc, crc16MatchesReference)
+{
+  uint8_t buf[600];
+  for (unsigned i = 0; i < sizeof(buf); i++)
+    buf[i] = i * 37 + (i >> 3);
+
+  // every length and alignment around the 4 bytes stride
+  for (uint32_t offset = 0; offset < 4; offset++) {
+    for (uint32_t len = 0; len + offset <= sizeof(buf); len += (len < 16 ? 1 : 61)) {
+      EXPECT_EQ(crc16Reference(0x1021, buf + offset, len, 0xFFFF),
+                crc16(CRC_1021, buf + offset, len, 0xFFFF));
+    }
+  }
+}
+
+TEST(Crc, crc16Incremental)
+{
+  uint8_t buf[257];
+  for (unsigned i = 0; i < sizeof(buf); i++)
+    buf[i] = 255 - i;
+
+  uint16_t whole = crc16(CRC_1021, buf, sizeof(buf));
+  for (uint32_t split = 0; split <= sizeof(buf); split += 13) {
+    uint16_t crc = crc16(CRC_1021, buf, split);
+    EXPECT_EQ(whole, crc16(CRC_1021, buf + split, sizeof(buf) - split, crc));
+  }
+}
+
+// run with --gtest_also_run_disabled_tests
+TEST(Crc, DISABLED_benchmark)
+{
+  static uint8_t buf[64 * 1024];
+  for (unsigned i = 0; i < sizeof(buf); i++)
+    buf[i] = i ^ (i >> 8);
+
+  const int rounds = 200;
+  uint16_t crc = 0;
+  uint16_t ref = 0;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < rounds; i++)
+    crc = crc16(CRC_1021, buf, sizeof(buf), crc);
+  auto sliced = std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < rounds; i++)
+    ref = crc16Reference(0x1021, buf, sizeof(buf), ref);
+  auto bitwise = std::chrono::steady_clock::now() - start;
+
+  EXPECT_EQ(ref, crc);
+
+  double mb = rounds * sizeof(buf) / (1024.0 * 1024.0);
+  printf("crc16: %.1f MB/s (bit-wise reference %.1f MB/s)\n",
+         mb / std::chrono::duration<double>(sliced).count(),
+         mb / std::chrono::duration<double>(bitwise).count());
+}
@@ -22,7 +22,7 @@
 #include "gtests.h"
 
 #if defined(CROSSFIRE)
-uint8_t createCrossfireChannelsFrame(uint8_t * frame, int16_t * pulses);
+uint8_t createCrossfireChannelsFrame(uint8_t * frame, int16_t * pulses, uint8_t nChannels);
 TEST(Crossfire, createCrossfireChannelsFrame)
 {
   int16_t pulsesStart[MAX_TRAINER_CHANNELS];
@@ -33,11 +33,32 @@ TEST(Crossfire, createCrossfireChannelsFrame)
     pulsesStart[i] = -1024 + (2048 / MAX_TRAINER_CHANNELS) * i;
   }
 
-  createCrossfireChannelsFrame(crossfire, pulsesStart);
+  createCrossfireChannelsFrame(crossfire, pulsesStart, CROSSFIRE_CHANNELS_COUNT);
 
   // TODO check
 }
 
+TEST(Crossfire, createCrossfireChannelsFramePartial)
+{
+  int16_t pulses[CROSSFIRE_CHANNELS_COUNT];
+  uint8_t partial[CROSSFIRE_FRAME_MAXLEN];
+  uint8_t full[CROSSFIRE_FRAME_MAXLEN];
+
+  for (int i=0; i<CROSSFIRE_CHANNELS_COUNT; i++) {
+    pulses[i] = (i < 4 ? 512 : 0);
+  }
+  createCrossfireChannelsFrame(full, pulses, CROSSFIRE_CHANNELS_COUNT);
+
+  // channels past nChannels must not be read and are sent at center
+  for (int i=4; i<CROSSFIRE_CHANNELS_COUNT; i++) {
+    pulses[i] = 1024;
+  }
+  uint8_t len = createCrossfireChannelsFrame(partial, pulses, 4);
+
+  ASSERT_EQ(len, 26);
+  ASSERT_EQ(0, memcmp(partial, full, len));
+}
+
 TEST(Crossfire, crc8)
 {
   uint8_t frame[] = { 0x00, 0x0C, 0x14, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x01, 0x03, 0x00, 0x00, 0x00, 0xF4 };
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "gtests.h"
+#include "fifo.h"
+
+TEST(Fifo, writeReadWrapAround)
+{
+  Fifo<uint8_t, 16> fifo;
+  uint8_t in[32], out[32];
+  for (uint8_t i = 0; i < sizeof(in); i++) in[i] = i;
+
+  // move the indexes close to the end of the buffer
+  EXPECT_EQ(fifo.write(in, 12), 12U);
+  EXPECT_EQ(fifo.read(out, 12), 12U);
+  EXPECT_TRUE(fifo.isEmpty());
+
+  // capacity is N - 1
+  EXPECT_EQ(fifo.write(in, sizeof(in)), 15U);
+  EXPECT_TRUE(fifo.isFull());
+  EXPECT_EQ(fifo.write(in, 1), 0U);
+
+  memclear(out, sizeof(out));
+  EXPECT_EQ(fifo.read(out, 10), 10U);
+  EXPECT_EQ(fifo.read(out + 10, sizeof(out)), 5U);
+  EXPECT_EQ(fifo.read(out, 1), 0U);
+  for (uint8_t i = 0; i < 15; i++) EXPECT_EQ(out[i], i);
+}
+
+TEST(Fifo, bulkMatchesSingleElement)
+{
+  Fifo<uint8_t, 32> bulk, single;
+  uint8_t value = 0, expected = 0;
+
+  for (int round = 0; round < 200; round++) {
+    uint8_t in[20];
+    uint32_t len = 1 + (round * 7) % sizeof(in);
+    for (uint32_t i = 0; i < len; i++) in[i] = value + i;
+
+    uint32_t written = bulk.write(in, len);
+    value += written;
+    for (uint32_t i = 0; i < written; i++) single.push(in[i]);
+    EXPECT_EQ(bulk.size(), single.size());
+
+    uint8_t out[20];
+    uint32_t count = bulk.read(out, 1 + (round * 5) % sizeof(out));
+    for (uint32_t i = 0; i < count; i++) {
+      uint8_t element;
+      EXPECT_TRUE(single.pop(element));
+      EXPECT_EQ(out[i], element);
+      EXPECT_EQ(out[i], expected++);
+    }
+    EXPECT_EQ(bulk.size(), single.size());
+  }
+}
+
+TEST(Fifo, contiguousSpans)
+{
+  Fifo<uint8_t, 8> fifo;
+  uint8_t * wptr;
+  const uint8_t * rptr;
+
+  // empty fifo: one slot is always kept free
+  EXPECT_EQ(fifo.reserveContiguous(wptr), 7U);
+  EXPECT_EQ(fifo.peekContiguous(rptr), 0U);
+
+  for (uint8_t i = 0; i < 6; i++) fifo.push(i);
+  EXPECT_EQ(fifo.peekContiguous(rptr), 6U);
+  EXPECT_EQ(rptr[0], 0);
+  fifo.commit(6);
+  EXPECT_TRUE(fifo.isEmpty());
+
+  // the writable span stops at the end of the buffer
+  EXPECT_EQ(fifo.reserveContiguous(wptr), 2U);
+  wptr[0] = 10;
+  wptr[1] = 11;
+  fifo.publish(2);
+  EXPECT_EQ(fifo.reserveContiguous(wptr), 5U);
+  EXPECT_EQ(wptr, fifo.buffer());
+  for (uint8_t i = 0; i < 5; i++) wptr[i] = 12 + i;
+  fifo.publish(5);
+  EXPECT_TRUE(fifo.isFull());
+  EXPECT_EQ(fifo.reserveContiguous(wptr), 0U);
+
+  // and so does the readable span
+  EXPECT_EQ(fifo.peekContiguous(rptr), 2U);
+  EXPECT_EQ(rptr[0], 10);
+  EXPECT_EQ(rptr[1], 11);
+  fifo.commit(2);
+  EXPECT_EQ(fifo.peekContiguous(rptr), 5U);
+  for (uint8_t i = 0; i < 5; i++) EXPECT_EQ(rptr[i], 12 + i);
+  fifo.commit(5);
+  EXPECT_TRUE(fifo.isEmpty());
+}
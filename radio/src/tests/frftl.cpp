@@ -0,0 +1,421 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include <chrono>
+#include "gtests.h"
+#include "drivers/frftl.h"
+
+#define FLASH_SIZE_MB      4
+#define FLASH_SIZE         (FLASH_SIZE_MB * 1024 * 1024)
+#define FLASH_PAGE_SIZE    4096
+#define FLASH_PAGE_COUNT   (FLASH_SIZE / FLASH_PAGE_SIZE)
+#define SECTOR_SIZE        512
+
+// NOR flash in RAM: programming can only clear bits, erasing sets a whole page
+static uint8_t* flash = nullptr;
+
+static struct {
+  uint64_t readBytes;
+  uint64_t programmedBytes;
+  uint32_t erases;
+  uint32_t pageErases[FLASH_PAGE_COUNT];
+} flashStats;
+
+// Power loss injection: program and erase operations are numbered from 1,
+// the one numbered powerLossAt is left half done and everything after fails
+static uint32_t flashOperations = 0;
+static uint32_t powerLossAt = 0;
+
+enum PowerState {
+  POWER_ON,
+  POWER_FAILING,
+  POWER_OFF
+};
+
+static PowerState powerState(bool newOperation)
+{
+  if (newOperation) flashOperations++;
+  if (powerLossAt == 0 || flashOperations < powerLossAt) return POWER_ON;
+  return (newOperation && flashOperations == powerLossAt) ? POWER_FAILING
+                                                          : POWER_OFF;
+}
+
+static bool ramFlashRead(uint32_t addr, uint8_t* buf, uint32_t len)
+{
+  if (addr + len > FLASH_SIZE || powerState(false) != POWER_ON) return false;
+  memcpy(buf, flash + addr, len);
+  flashStats.readBytes += len;
+  return true;
+}
+
+static bool ramFlashProgram(uint32_t addr, const uint8_t* buf, uint32_t len)
+{
+  if (addr + len > FLASH_SIZE) return false;
+  PowerState state = powerState(true);
+  if (state == POWER_OFF) return false;
+  if (state == POWER_FAILING) len /= 2;
+  for (uint32_t i = 0; i < len; i++) flash[addr + i] &= buf[i];
+  flashStats.programmedBytes += len;
+  return state == POWER_ON;
+}
+
+static bool ramFlashErase(uint32_t addr)
+{
+  if (addr % FLASH_PAGE_SIZE || addr >= FLASH_SIZE) return false;
+  PowerState state = powerState(true);
+  if (state == POWER_OFF) return false;
+  memset(flash + addr, 0xff, state == POWER_FAILING ? FLASH_PAGE_SIZE / 2 : FLASH_PAGE_SIZE);
+  flashStats.erases++;
+  flashStats.pageErases[addr / FLASH_PAGE_SIZE]++;
+  return state == POWER_ON;
+}
+
+static bool ramFlashIsErased(uint32_t addr)
+{
+  for (uint32_t i = 0; i < FLASH_PAGE_SIZE; i++) {
+    if (flash[addr + i] != 0xff) return false;
+  }
+  return true;
+}
+
+static const FrFTLOps ramFlashOps = {
+  .flashRead = ramFlashRead,
+  .flashProgram = ramFlashProgram,
+  .flashErase = ramFlashErase,
+  .isFlashErased = ramFlashIsErased,
+};
+
+static void fillSector(uint8_t* buf, uint32_t sectorNo, uint8_t generation)
+{
+  for (uint32_t i = 0; i < SECTOR_SIZE; i++) {
+    buf[i] = (uint8_t)(sectorNo * 7 + i + generation * 13);
+  }
+}
+
+class FrFTLTest : public testing::Test
+{
+ protected:
+  FrFTL ftl;
+
+  void SetUp() override
+  {
+    flash = (uint8_t*)malloc(FLASH_SIZE);
+    memset(flash, 0xff, FLASH_SIZE);
+    memclear(&flashStats, sizeof(flashStats));
+    flashOperations = 0;
+    powerLossAt = 0;
+    ASSERT_TRUE(ftlInit(&ftl, &ramFlashOps, FLASH_SIZE_MB));
+  }
+
+  void TearDown() override
+  {
+    ftlDeInit(&ftl);
+    free(flash);
+    flash = nullptr;
+  }
+
+  void reload()
+  {
+    ftlDeInit(&ftl);
+    ASSERT_TRUE(ftlInit(&ftl, &ramFlashOps, FLASH_SIZE_MB));
+  }
+
+  void writeSectors(uint32_t start, uint32_t count, uint8_t generation)
+  {
+    uint8_t buf[SECTOR_SIZE * 16];
+    while (count > 0) {
+      uint32_t n = count < 16 ? count : 16;
+      for (uint32_t i = 0; i < n; i++) {
+        fillSector(buf + i * SECTOR_SIZE, start + i, generation);
+      }
+      ASSERT_TRUE(ftlWrite(&ftl, start, n, buf));
+      start += n;
+      count -= n;
+    }
+  }
+
+  void checkPowerLoss(uint32_t step);
+
+  void checkSectors(uint32_t start, uint32_t count, uint8_t generation)
+  {
+    uint8_t buf[SECTOR_SIZE * 16];
+    uint8_t expected[SECTOR_SIZE];
+    while (count > 0) {
+      uint32_t n = count < 16 ? count : 16;
+      ASSERT_TRUE(ftlRead(&ftl, start, n, buf));
+      for (uint32_t i = 0; i < n; i++) {
+        fillSector(expected, start + i, generation);
+        ASSERT_EQ(0, memcmp(buf + i * SECTOR_SIZE, expected, SECTOR_SIZE))
+            << "sector " << start + i;
+      }
+      start += n;
+      count -= n;
+    }
+  }
+};
+
+TEST_F(FrFTLTest, multiSectorRead)
+{
+  // unaligned on page boundaries on purpose
+  writeSectors(3, 45, 1);
+
+  // pending changes are read back from the page buffers
+  checkSectors(3, 45, 1);
+
+  ASSERT_TRUE(ftlSync(&ftl));
+  checkSectors(3, 45, 1);
+
+  // sectors never written read as erased, also in the middle of a page
+  uint8_t buf[SECTOR_SIZE * 8];
+  ASSERT_TRUE(ftlRead(&ftl, 0, 8, buf));
+  for (uint32_t i = 0; i < 3 * SECTOR_SIZE; i++) ASSERT_EQ(buf[i], 0xff);
+  ASSERT_TRUE(ftlRead(&ftl, 48, 8, buf));
+  for (uint32_t i = 0; i < sizeof(buf); i++) ASSERT_EQ(buf[i], 0xff);
+
+  ASSERT_FALSE(ftlRead(&ftl, ftl.usableSectorCount - 1, 2, buf));
+
+  reload();
+  checkSectors(3, 45, 1);
+}
+
+TEST_F(FrFTLTest, garbageCollect)
+{
+  writeSectors(0, 256, 1);
+  ASSERT_TRUE(ftlSync(&ftl));
+
+  // rewriting releases the previous pages, but nothing is erased
+  // while they may still be referenced by the TT pages in flash
+  writeSectors(0, 256, 2);
+  uint32_t erases = flashStats.erases;
+  ASSERT_TRUE(ftlGarbageCollect(&ftl, 1));
+  EXPECT_EQ(flashStats.erases, erases);
+  ASSERT_TRUE(ftlSync(&ftl));
+
+  // rewrite enough to wrap around the flash a few times: with the released
+  // pages erased in the background, writing never has to erase on the fly
+  for (uint8_t generation = 3; generation < 200; generation++) {
+    int rounds = 0;
+    while (ftlGarbageCollect(&ftl, 8)) {
+      ASSERT_LT(++rounds, 1024);
+    }
+
+    erases = flashStats.erases;
+    writeSectors(0, 64, generation);
+    ASSERT_TRUE(ftlSync(&ftl));
+    EXPECT_EQ(flashStats.erases, erases) << "generation " << (int)generation;
+  }
+
+  checkSectors(0, 64, 199);
+  reload();
+  checkSectors(0, 64, 199);
+}
+
+// Every sector must hold either its content before the workload or the one
+// written by it, whatever flash operation the power was lost on
+static void powerLossWorkload(FrFTL* ftl)
+{
+  uint8_t buf[SECTOR_SIZE * 16];
+  for (uint32_t s = 5; s < 85; s += 16) {
+    for (uint32_t i = 0; i < 16; i++) fillSector(buf + i * SECTOR_SIZE, s + i, 2);
+    if (!ftlWrite(ftl, s, 16, buf)) return;
+  }
+  if (!ftlSync(ftl)) return;
+  if (!ftlTrim(ftl, 90, 6)) return;
+  ftlGarbageCollect(ftl, 4);
+  for (uint32_t i = 0; i < 3; i++) fillSector(buf + i * SECTOR_SIZE, i, 2);
+  if (!ftlWrite(ftl, 0, 3, buf)) return;
+  ftlSync(ftl);
+}
+
+void FrFTLTest::checkPowerLoss(uint32_t step)
+{
+  const uint32_t sectors = 96;
+
+  writeSectors(0, sectors, 1);
+  ASSERT_TRUE(ftlSync(&ftl));
+  std::vector<uint8_t> image(flash, flash + FLASH_SIZE);
+
+  reload();
+  flashOperations = 0;
+  powerLossWorkload(&ftl);
+  uint32_t operations = flashOperations;
+  ASSERT_GT(operations, 10U);
+
+  for (uint32_t lossAt = 1; lossAt <= operations; lossAt += step) {
+    SCOPED_TRACE(testing::Message() << "power lost on operation " << lossAt);
+
+    memcpy(flash, image.data(), FLASH_SIZE);
+    reload();
+    powerLossAt = lossAt;
+    flashOperations = 0;
+    powerLossWorkload(&ftl);
+
+    // restart
+    powerLossAt = 0;
+    reload();
+
+    uint8_t buf[SECTOR_SIZE];
+    uint8_t before[SECTOR_SIZE];
+    uint8_t after[SECTOR_SIZE];
+    uint8_t erased[SECTOR_SIZE];
+    memset(erased, 0xff, sizeof(erased));
+    for (uint32_t s = 0; s < sectors; s++) {
+      ASSERT_TRUE(ftlRead(&ftl, s, 1, buf));
+      fillSector(before, s, 1);
+      fillSector(after, s, 2);
+      bool rewritten = s < 3 || (s >= 5 && s < 85);
+      bool trimmed = s >= 90;
+      ASSERT_TRUE(!memcmp(buf, before, SECTOR_SIZE) ||
+                  (rewritten && !memcmp(buf, after, SECTOR_SIZE)) ||
+                  (trimmed && !memcmp(buf, erased, SECTOR_SIZE)))
+          << "sector " << s;
+    }
+
+    // and the FTL is still usable
+    writeSectors(0, sectors, 3);
+    ASSERT_TRUE(ftlSync(&ftl));
+    checkSectors(0, sectors, 3);
+  }
+}
+
+TEST_F(FrFTLTest, powerLoss)
+{
+  checkPowerLoss(13);
+}
+
+TEST_F(FrFTLTest, DISABLED_powerLossOnEveryOperation)
+{
+  checkPowerLoss(1);
+}
+
+TEST_F(FrFTLTest, DISABLED_benchmark)
+{
+  const uint32_t chunk = 64;  // sectors per request, as FatFs does on big files
+  const uint32_t total = 2 * 1024 * 1024 / SECTOR_SIZE;
+  uint8_t* buf = (uint8_t*)malloc(chunk * SECTOR_SIZE);
+
+  for (int pass = 0; pass < 3; pass++) {
+    memclear(&flashStats, sizeof(flashStats));
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t s = 0; s < total; s += chunk) {
+      for (uint32_t i = 0; i < chunk; i++) {
+        fillSector(buf + i * SECTOR_SIZE, s + i, pass);
+      }
+      ASSERT_TRUE(ftlWrite(&ftl, s, chunk, buf));
+    }
+    ASSERT_TRUE(ftlSync(&ftl));
+    std::chrono::duration<double> writeTime =
+        std::chrono::steady_clock::now() - start;
+    uint64_t programmed = flashStats.programmedBytes;
+    uint32_t erases = flashStats.erases;
+
+    start = std::chrono::steady_clock::now();
+    for (uint32_t s = 0; s < total; s += chunk) {
+      ASSERT_TRUE(ftlRead(&ftl, s, chunk, buf));
+    }
+    std::chrono::duration<double> readTime =
+        std::chrono::steady_clock::now() - start;
+
+    double mb = total * SECTOR_SIZE / 1048576.0;
+    printf("pass %d: write %.1f MB/s, read %.1f MB/s, write amplification %.2f, "
+           "%u erases\n",
+           pass, mb / writeTime.count(), mb / readTime.count(),
+           (double)programmed / (total * SECTOR_SIZE), erases);
+
+    while (ftlGarbageCollect(&ftl, 16));
+  }
+
+  free(buf);
+}
+
+static void reportWear(const char* name, uint64_t hostBytes,
+                       std::chrono::duration<double> time)
+{
+  uint32_t minErases = UINT32_MAX;
+  uint32_t maxErases = 0;
+  for (uint32_t i = 0; i < FLASH_PAGE_COUNT; i++) {
+    if (flashStats.pageErases[i] < minErases) minErases = flashStats.pageErases[i];
+    if (flashStats.pageErases[i] > maxErases) maxErases = flashStats.pageErases[i];
+  }
+
+  printf("%s: %.2f MB/s, write amplification %.2f, %u erases "
+         "(per page min %u, avg %.1f, max %u)\n",
+         name, hostBytes / 1048576.0 / time.count(),
+         (double)flashStats.programmedBytes / hostBytes, flashStats.erases,
+         minErases, (double)flashStats.erases / FLASH_PAGE_COUNT, maxErases);
+}
+
+// A model file rewritten in place, along with its FAT and directory sectors
+TEST_F(FrFTLTest, DISABLED_modelSaves)
+{
+  const uint32_t saves = 2000;
+  uint8_t buf[SECTOR_SIZE * 6];
+  uint64_t hostBytes = 0;
+  memclear(&flashStats, sizeof(flashStats));
+
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t n = 0; n < saves; n++) {
+    for (uint32_t i = 0; i < 6; i++) fillSector(buf + i * SECTOR_SIZE, 1000 + i, n);
+    ASSERT_TRUE(ftlWrite(&ftl, 1000, 6, buf));
+    ASSERT_TRUE(ftlWrite(&ftl, 32, 1, buf));
+    ASSERT_TRUE(ftlWrite(&ftl, 64, 1, buf));
+    ASSERT_TRUE(ftlSync(&ftl));
+    hostBytes += 8 * SECTOR_SIZE;
+
+    // the radio sits idle between saves
+    if (n % 16 == 15) {
+      while (ftlGarbageCollect(&ftl, 16));
+    }
+  }
+  reportWear("model saves", hostBytes, std::chrono::steady_clock::now() - start);
+}
+
+// A telemetry log growing one sector at a time, the FAT being updated on
+// every new cluster and the file synced every few records
+TEST_F(FrFTLTest, DISABLED_logAppends)
+{
+  const uint32_t appends = 6000;
+  uint8_t buf[SECTOR_SIZE];
+  uint64_t hostBytes = 0;
+  memclear(&flashStats, sizeof(flashStats));
+
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t n = 0; n < appends; n++) {
+    fillSector(buf, 200 + n, 0);
+    ASSERT_TRUE(ftlWrite(&ftl, 200 + n, 1, buf));
+    hostBytes += SECTOR_SIZE;
+    if (n % 8 == 7) {
+      ASSERT_TRUE(ftlWrite(&ftl, 32, 1, buf));
+      hostBytes += SECTOR_SIZE;
+    }
+    if (n % 16 == 15) {
+      ASSERT_TRUE(ftlSync(&ftl));
+    }
+    if (n % 256 == 255) {
+      while (ftlGarbageCollect(&ftl, 16));
+    }
+  }
+  ASSERT_TRUE(ftlSync(&ftl));
+  reportWear("log appends", hostBytes, std::chrono::steady_clock::now() - start);
+  checkSectors(200, appends, 0);
+}
@@ -406,6 +406,45 @@ TEST(FrSkySPORT, frskySetCellVoltageTwoSensors)
   EXPECT_EQ(telemetryItems[2].valueMax, 287);
 }
 
+TEST(FrSkySPORT, calculatedSensorsChain)
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+  telemetryData.telemetryValid = 0x07;
+  allowNewSensors = true;
+
+  setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, VFAS_FIRST_ID, 0, 1, 1200, UNIT_VOLTS, 2);
+
+  // sensor 2 uses sensor 3, which comes after it
+  g_model.telemetrySensors[1].type = TELEM_TYPE_CALCULATED;
+  g_model.telemetrySensors[1].formula = TELEM_FORMULA_ADD;
+  g_model.telemetrySensors[1].unit = UNIT_VOLTS;
+  g_model.telemetrySensors[1].prec = 2;
+  g_model.telemetrySensors[1].calc.sources[0] = 3;
+  g_model.telemetrySensors[1].calc.sources[1] = 3;
+
+  g_model.telemetrySensors[2].type = TELEM_TYPE_CALCULATED;
+  g_model.telemetrySensors[2].formula = TELEM_FORMULA_MAX;
+  g_model.telemetrySensors[2].unit = UNIT_VOLTS;
+  g_model.telemetrySensors[2].prec = 2;
+  g_model.telemetrySensors[2].calc.sources[0] = 1;
+
+  telemetryWakeup();
+  EXPECT_EQ(telemetryItems[2].value, 1200);
+  EXPECT_EQ(telemetryItems[1].value, 2400);
+
+  // nothing changed, nothing is evaluated
+  telemetryItems[1].value = 0;
+  telemetryWakeup();
+  EXPECT_EQ(telemetryItems[1].value, 0);
+
+  setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, VFAS_FIRST_ID, 0, 1, 1100, UNIT_VOLTS, 2);
+  telemetryWakeup();
+  EXPECT_EQ(telemetryItems[2].value, 1100);
+  EXPECT_EQ(telemetryItems[1].value, 2200);
+}
+
 void generateSportFasVoltagePacket(uint8_t * packet, uint32_t voltage)
 {
   packet[0] = 0x22; //DATA_ID_FAS
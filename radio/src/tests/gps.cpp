@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "gtests.h"
+#include "gps_ubx.h"
+
+// u-blox receiver switching to UBX: the end of the last NMEA sentence,
+// NAV-PVT, ACK-ACK for CFG-RATE, a NAV-PVT hit by line noise, NAV-PVT
+static const uint8_t UBX_STREAM[] = {
+  0x24, 0x47, 0x4E, 0x47, 0x47, 0x41, 0x2C, 0x31, 0x30, 0x32, 0x32, 0x33,
+  0x33, 0x2E, 0x30, 0x30, 0x2C, 0x34, 0x37, 0x32, 0x33, 0x2E, 0x38, 0x36,
+  0x34, 0x35, 0x31, 0x2C, 0x4E, 0x2C, 0x30, 0x30, 0x38, 0x33, 0x32, 0x2E,
+  0x37, 0x33, 0x35, 0x36, 0x33, 0x2C, 0x45, 0x2C, 0x31, 0x2C, 0x31, 0x32,
+  0x2C, 0x30, 0x2E, 0x38, 0x30, 0x2C, 0x34, 0x38, 0x38, 0x2E, 0x30, 0x2C,
+  0x4D, 0x2C, 0x34, 0x37, 0x2E, 0x30, 0x2C, 0x4D, 0x2C, 0x2C, 0x2A, 0x34,
+  0x41, 0x0D, 0x0A, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0x00, 0xCA, 0x5B,
+  0x07, 0xE7, 0x07, 0x05, 0x0E, 0x0A, 0x16, 0x21, 0x07, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0x00, 0x0E, 0x42, 0xF4, 0x17,
+  0x05, 0x4B, 0x52, 0x40, 0x1C, 0xD8, 0x29, 0x08, 0x00, 0x40, 0x72, 0x07,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x39, 0x30, 0x00,
+  0x00, 0x79, 0x84, 0x89, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x7B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x62, 0x6F, 0xB5, 0x62, 0x05, 0x01, 0x02,
+  0x00, 0x06, 0x08, 0x16, 0x3F, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0x00,
+  0xCA, 0x5B, 0x07, 0xE7, 0x07, 0x05, 0x0E, 0x0A, 0x16, 0x21, 0x07, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0x00, 0x0E, 0x17,
+  0xF4, 0x17, 0x05, 0x4B, 0x52, 0x40, 0x1C, 0xD8, 0x29, 0x08, 0x00, 0x40,
+  0x72, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x39,
+  0x30, 0x00, 0x00, 0x79, 0x84, 0x89, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x7B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x62, 0x6F, 0xB5, 0x62, 0x01,
+  0x07, 0x5C, 0x00, 0x28, 0xCA, 0x5B, 0x07, 0xE7, 0x07, 0x05, 0x0E, 0x0A,
+  0x16, 0x21, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02,
+  0x01, 0x00, 0x09, 0x80, 0xF4, 0x17, 0x05, 0x9C, 0x52, 0x40, 0x1C, 0xD4,
+  0xAD, 0x00, 0x00, 0x3C, 0xF6, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x20, 0x4E, 0x00, 0x00, 0xC0, 0xBD, 0xF0, 0xFF, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFA, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x6C,
+  0xBF,
+};
+
+struct UbxStreamResult {
+  int frames = 0;
+  int errors = 0;
+  int navPvt = 0;
+  int ack = 0;
+  UbxParser parser;
+};
+
+static void parseStream(UbxStreamResult& result, const uint8_t* stream,
+                        uint32_t len, uint8_t* lastPvt)
+{
+  ubxParserInit(&result.parser);
+  for (uint32_t i = 0; i < len; i++) {
+    auto res = ubxParseByte(&result.parser, stream[i]);
+    if (res == UBX_PARSE_ERROR) {
+      result.errors++;
+    } else if (res == UBX_PARSE_FRAME) {
+      result.frames++;
+      if (result.parser.msgClass == UBX_CLASS_NAV &&
+          result.parser.msgId == UBX_NAV_PVT) {
+        EXPECT_EQ(UBX_NAV_PVT_LEN, result.parser.length);
+        memcpy(lastPvt, result.parser.payload, UBX_NAV_PVT_LEN);
+        result.navPvt++;
+      } else if (result.parser.msgClass == UBX_CLASS_ACK &&
+                 result.parser.msgId == UBX_ACK_ACK) {
+        EXPECT_EQ(UBX_CLASS_CFG, ubxU1(result.parser.payload, 0));
+        EXPECT_EQ(UBX_CFG_RATE, ubxU1(result.parser.payload, 1));
+        result.ack++;
+      }
+    }
+  }
+}
+
+TEST(GpsUbx, navPvtStream)
+{
+  UbxStreamResult result;
+  uint8_t pvt[UBX_NAV_PVT_LEN];
+  parseStream(result, UBX_STREAM, sizeof(UBX_STREAM), pvt);
+
+  EXPECT_EQ(3, result.frames);
+  EXPECT_EQ(2, result.navPvt);
+  EXPECT_EQ(1, result.ack);
+  EXPECT_EQ(1, result.errors);
+  EXPECT_FALSE(ubxParserBusy(&result.parser));
+
+  // last NAV-PVT
+  EXPECT_EQ(2023, ubxU2(pvt, UBX_NAV_PVT_YEAR));
+  EXPECT_EQ(5, ubxU1(pvt, UBX_NAV_PVT_MONTH));
+  EXPECT_EQ(14, ubxU1(pvt, UBX_NAV_PVT_DAY));
+  EXPECT_EQ(10, ubxU1(pvt, UBX_NAV_PVT_HOUR));
+  EXPECT_EQ(22, ubxU1(pvt, UBX_NAV_PVT_MIN));
+  EXPECT_EQ(33, ubxU1(pvt, UBX_NAV_PVT_SEC));
+  EXPECT_EQ(UBX_NAV_PVT_VALID_DATE | UBX_NAV_PVT_VALID_TIME,
+            ubxU1(pvt, UBX_NAV_PVT_VALID) & 0x03);
+  EXPECT_EQ(UBX_NAV_PVT_FIX_2D, ubxU1(pvt, UBX_NAV_PVT_FIX_TYPE));
+  EXPECT_EQ(UBX_NAV_PVT_FLAGS_FIX_OK, ubxU1(pvt, UBX_NAV_PVT_FLAGS));
+  EXPECT_EQ(9, ubxU1(pvt, UBX_NAV_PVT_NUM_SV));
+  EXPECT_EQ(473977500, ubxI4(pvt, UBX_NAV_PVT_LAT));
+  EXPECT_EQ(85456000, ubxI4(pvt, UBX_NAV_PVT_LON));
+  EXPECT_EQ(-2500, ubxI4(pvt, UBX_NAV_PVT_HMSL));
+  EXPECT_EQ(20000, ubxI4(pvt, UBX_NAV_PVT_GSPEED));
+  EXPECT_EQ(-1000000, ubxI4(pvt, UBX_NAV_PVT_HEAD_MOT));
+  EXPECT_EQ(250, ubxU2(pvt, UBX_NAV_PVT_PDOP));
+}
+
+TEST(GpsUbx, resyncAfterTruncation)
+{
+  // every truncation of the stream leaves the parser able to decode
+  // the next complete frame
+  for (uint32_t cut = 0; cut < sizeof(UBX_STREAM); cut += 7) {
+    UbxStreamResult result;
+    uint8_t pvt[UBX_NAV_PVT_LEN];
+    uint8_t stream[sizeof(UBX_STREAM) * 2];
+    memcpy(stream, UBX_STREAM + cut, sizeof(UBX_STREAM) - cut);
+    memcpy(stream + sizeof(UBX_STREAM) - cut, UBX_STREAM, sizeof(UBX_STREAM));
+    parseStream(result, stream, sizeof(UBX_STREAM) * 2 - cut, pvt);
+    EXPECT_GE(result.navPvt, 2);
+    EXPECT_EQ(473977500, ubxI4(pvt, UBX_NAV_PVT_LAT));
+  }
+}
+
+TEST(GpsUbx, oversizedFrameSkipped)
+{
+  static uint8_t payload[UBX_MAX_PAYLOAD + 50];
+  for (unsigned i = 0; i < sizeof(payload); i++)
+    payload[i] = i;
+
+  uint8_t stream[sizeof(payload) + UBX_FRAME_OVERHEAD + sizeof(UBX_STREAM)];
+  uint16_t len = ubxBuildFrame(stream, UBX_CLASS_NAV, 0x35, payload,
+                               sizeof(payload));
+  EXPECT_EQ(sizeof(payload) + UBX_FRAME_OVERHEAD, len);
+  memcpy(stream + len, UBX_STREAM, sizeof(UBX_STREAM));
+
+  UbxStreamResult result;
+  uint8_t pvt[UBX_NAV_PVT_LEN];
+  parseStream(result, stream, len + sizeof(UBX_STREAM), pvt);
+  EXPECT_EQ(3, result.frames);
+  EXPECT_EQ(1, result.errors);
+}
+
+TEST(GpsUbx, buildFrame)
+{
+  // CFG-RATE: 100ms, navRate 1, GPS time
+  static const uint8_t cfgRate[] = { 0x64, 0x00, 0x01, 0x00, 0x01, 0x00 };
+  static const uint8_t expected[] = { 0xB5, 0x62, 0x06, 0x08, 0x06, 0x00, 0x64,
+                                      0x00, 0x01, 0x00, 0x01, 0x00, 0x7A, 0x12 };
+  uint8_t frame[sizeof(cfgRate) + UBX_FRAME_OVERHEAD];
+  EXPECT_EQ(sizeof(expected), ubxBuildFrame(frame, UBX_CLASS_CFG, UBX_CFG_RATE,
+                                            cfgRate, sizeof(cfgRate)));
+  EXPECT_EQ(0, memcmp(expected, frame, sizeof(expected)));
+
+  // and back through the parser
+  UbxParser parser;
+  ubxParserInit(&parser);
+  for (unsigned i = 0; i < sizeof(expected) - 1; i++)
+    EXPECT_EQ(UBX_PARSE_NONE, ubxParseByte(&parser, expected[i]));
+  EXPECT_EQ(UBX_PARSE_FRAME,
+            ubxParseByte(&parser, expected[sizeof(expected) - 1]));
+  EXPECT_EQ(100, ubxU2(parser.payload, 0));
+}
@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <chrono>
+#include <string>
+
+#include "gtests.h"
+#include "location.h"
+
+#if defined(SDCARD)
+
+class LogsTest : public OpenTxTest
+{
+  protected:
+    void SetUp() override
+    {
+      OpenTxTest::SetUp();
+      simuFatfsSetPaths(TESTS_BUILD_PATH "/", TESTS_BUILD_PATH "/");
+      removeLogs();
+      strcpy(g_model.header.name, "logtest");
+      logsInit();
+      logDelay100ms = 1;
+      modelFunctionsContext.activeFunctions |= (1u << FUNCTION_LOGS);
+    }
+
+    void TearDown() override
+    {
+      logsClose();
+      modelFunctionsContext.reset();
+      removeLogs();
+    }
+
+    static bool findLog(std::string & path)
+    {
+      DIR dir;
+      FILINFO info;
+      if (f_opendir(&dir, LOGS_PATH) != FR_OK)
+        return false;
+      bool found = false;
+      while (!found && f_readdir(&dir, &info) == FR_OK && info.fname[0]) {
+        if (!strncmp(info.fname, "logtest", 7)) {
+          path = std::string(LOGS_PATH "/") + info.fname;
+          found = true;
+        }
+      }
+      f_closedir(&dir);
+      return found;
+    }
+
+    static void removeLogs()
+    {
+      std::string path;
+      while (findLog(path)) {
+        f_unlink(path.c_str());
+      }
+    }
+
+    static std::string readLog()
+    {
+      std::string path, content;
+      if (!findLog(path))
+        return content;
+      FIL file;
+      if (f_open(&file, path.c_str(), FA_READ) != FR_OK)
+        return content;
+      char buffer[256];
+      UINT read;
+      while (f_read(&file, buffer, sizeof(buffer), &read) == FR_OK && read > 0) {
+        content.append(buffer, read);
+      }
+      f_close(&file);
+      return content;
+    }
+
+    static FSIZE_t logSize()
+    {
+      std::string path;
+      FILINFO info;
+      if (!findLog(path) || f_stat(path.c_str(), &info) != FR_OK)
+        return 0;
+      return info.fsize;
+    }
+
+    static void writeLines(int count)
+    {
+      for (int i = 0; i < count; i++) {
+        g_tmr10ms += 10;
+        logsWrite();
+      }
+    }
+};
+
+static int countLines(const std::string & content)
+{
+  int lines = 0;
+  for (char c: content) {
+    if (c == '\n')
+      lines++;
+  }
+  return lines;
+}
+
+TEST_F(LogsTest, writeAndTruncate)
+{
+  writeLines(100);
+  // the file is expanded when it is created
+  EXPECT_EQ(LOGS_PREALLOC_SIZE, logSize());
+  logsClose();
+
+  std::string content = readLog();
+  EXPECT_EQ(f_tell(&g_oLogFile), logSize());
+  EXPECT_EQ(content.size(), logSize());
+  // header + lines, no trailing reserved space
+  EXPECT_EQ(101, countLines(content));
+  ASSERT_FALSE(content.empty());
+  EXPECT_EQ('\n', content.back());
+  EXPECT_EQ(std::string::npos, content.find('\0'));
+#if defined(RTCLOCK)
+  EXPECT_EQ(0, content.compare(0, 10, "Date,Time,"));
+#else
+  EXPECT_EQ(0, content.compare(0, 5, "Time,"));
+#endif
+}
+
+TEST_F(LogsTest, appendToExistingLog)
+{
+  writeLines(10);
+  logsClose();
+  size_t size = readLog().size();
+
+  // same file is reopened in append mode, header is not written again
+  writeLines(10);
+  logsClose();
+
+  std::string content = readLog();
+  EXPECT_EQ(21, countLines(content));
+  EXPECT_LT(size, content.size());
+}
+
+TEST_F(LogsTest, flushBySector)
+{
+  // lines stay in RAM until whole sectors can be written
+  for (int i = 0; i < 50; i++) {
+    writeLines(1);
+    EXPECT_EQ(0u, f_tell(&g_oLogFile) % FF_MAX_SS);
+  }
+
+  // the remainder is written on close
+  FSIZE_t written = f_tell(&g_oLogFile);
+  EXPECT_GT(written, 0u);
+  logsClose();
+  EXPECT_LT(written, readLog().size());
+}
+
+TEST_F(LogsTest, reserveByChunks)
+{
+  // write past the first chunk: the file is stretched by another one
+  while (f_tell(&g_oLogFile) < LOGS_PREALLOC_SIZE)
+    writeLines(100);
+  FSIZE_t size = logSize();
+  EXPECT_LT(2 * LOGS_PREALLOC_SIZE, size);
+  EXPECT_LT(f_tell(&g_oLogFile), size);
+
+  logsClose();
+  EXPECT_EQ(f_tell(&g_oLogFile), logSize());
+  EXPECT_EQ(std::string::npos, readLog().find('\0'));
+}
+
+// Run with --gtest_also_run_disabled_tests --gtest_filter=LogsTest.DISABLED_*
+TEST_F(LogsTest, DISABLED_benchmark)
+{
+  const int count = 20000;
+
+  auto start = std::chrono::steady_clock::now();
+  writeLines(count);
+  logsClose();
+  auto elapsed = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+
+  size_t size = readLog().size();
+  printf("%d lines, %u bytes in %.3fs: %.0f lines/s, %.1f MB/s\n", count,
+         (unsigned)size, elapsed, count / elapsed, size / elapsed / 1e6);
+  EXPECT_EQ(count + 1, countLines(readLog()));
+}
+
+#endif
@@ -26,13 +26,17 @@
 
 #define SWAP_DEFINED
 #include "opentx.h"
+#include "telemetry/telemetry_history.h"
 
 
 ::testing::AssertionResult __luaExecStr(const char * str)
 {
   extern lua_State * lsScripts;
+  extern tmr10ms_t luaCycleStart;
   if (!lsScripts) luaInit();
   if (!lsScripts) return ::testing::AssertionFailure() << "No Lua state!";
+  // each chunk runs as a new cycle, the scripts are not preempted
+  luaCycleStart = get_tmr10ms();
   if (luaL_dostring(lsScripts, str)) {
     return ::testing::AssertionFailure() << "lua error: " << lua_tostring(lsScripts, -1);
   }
@@ -170,4 +174,35 @@ TEST(Lua, Switches)
   luaExecStr("if MIXSRC_SB == nil then error('failed') end");
 }
 
+TEST(Lua, sensorHistory)
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  telemetryHistory.reset();
+  telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+  allowNewSensors = true;
+
+  setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, VFAS_FIRST_ID, 0, 1, 1200, UNIT_VOLTS, 2);
+  luaExecStr("if getSensorHistory(0) ~= nil then error('no history') end");
+  luaExecStr("if not setSensorHistory(0, 10, 1) then error('setSensorHistory') end");
+
+  for (int i = 0; i < 4; i++) {
+    g_tmr10ms++;
+    setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, VFAS_FIRST_ID, 0, 1, 1200 + i * 10, UNIT_VOLTS, 2);
+  }
+
+  luaExecStr("v = getSensorHistory(0)");
+  luaExecStr("function near(a, b) return math.abs(a - b) < 0.001 end");
+  luaExecStr("if #v ~= 4 or not near(v[1], 12.0) or not near(v[4], 12.3) then error('values') end");
+  luaExecStr("mins, maxs = getSensorHistory(0, 4, 2)");
+  luaExecStr("if #mins ~= 2 or not near(mins[1], 12.0) or not near(maxs[1], 12.1) or not near(maxs[2], 12.3) then error('minmax') end");
+
+  // the last value is held while the sensor is silent
+  g_tmr10ms += 2;
+  luaExecStr("v = getSensorHistory(0)");
+  luaExecStr("if #v ~= 6 or not near(v[4], 12.3) or not near(v[6], 12.3) then error('silent') end");
+  luaExecStr("if setSensorHistory(0, 0) then error('stop') end");
+  luaExecStr("if getSensorHistory(0) ~= nil then error('stopped') end");
+}
+
 #endif   // #if defined(LUA)
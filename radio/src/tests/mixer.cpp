@@ -21,6 +21,7 @@
 
 #include "gtests.h"
 #include "hal/adc_driver.h"
+#include "tasks/mixer_task.h"
 
 class TrimsTest : public OpenTxTest {};
 class MixerTest : public OpenTxTest {};
@@ -524,6 +525,31 @@ TEST(Curves, LinearIntpol)
   EXPECT_EQ(applyCustomCurve(-192, 0), -192);
 }
 
+TEST(Curves, SmoothCurveFollowsEdits)
+{
+  SYSTEM_RESET();
+  MODEL_RESET();
+  MIXER_RESET();
+  setModelDefaults();
+  loadCurves();
+  g_model.curves[0].smooth = 1;
+  for (int8_t i=-2; i<=2; i++) {
+    g_model.points[2+i] = 50*i;
+  }
+  storageDirty(EE_MODEL);
+  EXPECT_EQ(applyCustomCurve(256, 0), 256);
+  EXPECT_EQ(applyCustomCurve(-1024, 0), -1024);
+
+  curveMirror(0);
+  EXPECT_EQ(applyCustomCurve(256, 0), -256);
+
+  for (int8_t i=0; i<5; i++) {
+    g_model.points[i] = 0;
+  }
+  storageDirty(EE_MODEL);
+  EXPECT_EQ(applyCustomCurve(256, 0), 0);
+}
+
 
 
 TEST_F(MixerTest, InfiniteRecursiveChannels)
@@ -552,6 +578,79 @@ TEST_F(MixerTest, BlockingChannel)
   EXPECT_EQ(chans[0], 0);
 }
 
+static void storeSweepPoint(int16_t value, const int32_t * chans, void * ctx)
+{
+  ((std::vector<int32_t> *)ctx)->push_back(chans[0]);
+}
+
+TEST_F(MixerTest, SweepKeepsLiveState)
+{
+  g_model.mixData[0].destCh = 0;
+  g_model.mixData[0].srcRaw = MIXSRC_FIRST_STICK;
+  g_model.mixData[0].weight = 100;
+
+  std::vector<int32_t> expected;
+  for (int value = -1024; value <= 1024; value += 512) {
+    anaSetFiltered(0, value);
+    evalFlightModeMixes(e_perout_mode_normal, 0);
+    expected.push_back(chans[0]);
+  }
+
+  anaSetFiltered(0, 512);
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  int32_t live = chans[0];
+  uint16_t liveInput = anaIn(0);
+
+  std::vector<int32_t> sweep;
+  EXPECT_TRUE(evalMixerSweep(0, 0, -1024, 1024, 512, storeSweepPoint, &sweep));
+
+  EXPECT_EQ(sweep, expected);
+  EXPECT_EQ(chans[0], live);
+  EXPECT_EQ(anaIn(0), liveInput);
+
+  // the mixer task is released
+  EXPECT_TRUE(mixerTaskTryLock());
+  mixerTaskUnlock();
+
+  EXPECT_FALSE(evalMixerSweep(0, 0, -1024, 1024, 0, storeSweepPoint, &sweep));
+}
+
+TEST_F(MixerTest, SweepOtherFlightModeKeepsInputTrims)
+{
+  // input 0 uses trim 0 in FM0 and trim 1 in FM1
+  g_model.expoData[0].chn = 0;
+  g_model.expoData[0].mode = 3;
+  g_model.expoData[0].srcRaw = MIXSRC_FIRST_STICK;
+  g_model.expoData[0].weight = 100;
+  g_model.expoData[0].trimSource = TRIM_ON;
+  g_model.expoData[0].flightModes = 0x1FE;
+  g_model.expoData[1].chn = 0;
+  g_model.expoData[1].mode = 3;
+  g_model.expoData[1].srcRaw = MIXSRC_FIRST_STICK;
+  g_model.expoData[1].weight = 100;
+  g_model.expoData[1].trimSource = -2;
+  g_model.expoData[1].flightModes = 0x1FD;
+  g_model.mixData[0].destCh = 0;
+  g_model.mixData[0].srcRaw = MIXSRC_FIRST_INPUT;
+  g_model.mixData[0].weight = 100;
+  g_model.flightModeData[0].trim[0].value = 100;
+  g_model.flightModeData[1].trim[1].value = -100;
+
+  anaSetFiltered(0, 0);
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  EXPECT_EQ(0, virtualInputsTrims[0]);
+  int32_t live = chans[0];
+
+  std::vector<int32_t> sweep;
+  EXPECT_TRUE(evalMixerSweep(1, 0, 0, 0, 1, storeSweepPoint, &sweep));
+  ASSERT_EQ(1u, sweep.size());
+  EXPECT_NE(live, sweep[0]);
+
+  // live state still refers to the FM0 trim
+  EXPECT_EQ(0, virtualInputsTrims[0]);
+  EXPECT_EQ(chans[0], live);
+}
+
 TEST_F(MixerTest, RecursiveAddChannel)
 {
   g_model.mixData[0].destCh = 0;
@@ -1017,3 +1116,18 @@ TEST_F(TrimsTest, invertedThrottlePlusThrottleTrimWithCrossTrims)
   EXPECT_EQ(channelOutputs[2], +1024);
   EXPECT_EQ(channelOutputs[1], 0);
 }
+
+TEST_F(MixerTest, MixSourceChange)
+{
+  g_model.mixData[0].destCh = 0;
+  g_model.mixData[0].mltpx = MLTPX_ADD;
+  g_model.mixData[0].srcRaw = MIXSRC_MAX;
+  g_model.mixData[0].weight = 100;
+  evalMixes(1);
+  EXPECT_EQ(chans[0], CHANNEL_MAX);
+
+  // the source of a line is resolved again when it is edited
+  g_model.mixData[0].srcRaw = MIXSRC_MIN;
+  evalMixes(1);
+  EXPECT_EQ(chans[0], -CHANNEL_MAX);
+}
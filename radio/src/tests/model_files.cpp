@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <string>
+
+#include "gtests.h"
+#include "location.h"
+
+#if defined(SDCARD_YAML) && !defined(STORAGE_MODELSLIST)
+
+#include "storage/sdcard_common.h"
+
+#define MODEL1    MODELS_PATH "/model01" YAML_EXT
+#define MODEL2    MODELS_PATH "/model02" YAML_EXT
+#define MODEL1TMP MODELS_PATH "/model01" TMPFILE_EXT
+#define SWAPFILE  MODELS_PATH "/model01-model02" SWAPFILE_EXT
+
+class ModelFilesTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+      simuFatfsSetPaths(TESTS_BUILD_PATH "/", TESTS_BUILD_PATH "/");
+      sdCheckAndCreateDirectory(MODELS_PATH);
+      cleanup();
+    }
+
+    void TearDown() override
+    {
+      cleanup();
+    }
+
+    static void cleanup()
+    {
+      f_unlink(MODEL1);
+      f_unlink(MODEL2);
+      f_unlink(MODEL1TMP);
+      f_unlink(SWAPFILE);
+    }
+
+    static void writeFile(const char * path, const char * content)
+    {
+      FIL file;
+      UINT written;
+      ASSERT_EQ(FR_OK, f_open(&file, path, FA_CREATE_ALWAYS | FA_WRITE));
+      f_write(&file, content, strlen(content), &written);
+      f_close(&file);
+    }
+
+    static std::string readFile(const char * path)
+    {
+      std::string content;
+      FIL file;
+      if (f_open(&file, path, FA_READ) != FR_OK)
+        return "<missing>";
+      char buffer[64];
+      UINT read;
+      while (f_read(&file, buffer, sizeof(buffer), &read) == FR_OK && read > 0) {
+        content.append(buffer, read);
+      }
+      f_close(&file);
+      return content;
+    }
+
+    static bool exists(const char * path)
+    {
+      FILINFO info;
+      return f_stat(path, &info) == FR_OK;
+    }
+};
+
+TEST_F(ModelFilesTest, interruptedWrite)
+{
+  // complete temporary file, original already removed
+  writeFile(MODEL1TMP, "new");
+  recoverModelFiles();
+  EXPECT_EQ("new", readFile(MODEL1));
+  EXPECT_FALSE(exists(MODEL1TMP));
+
+  // temporary file next to its original is not used
+  writeFile(MODEL1TMP, "partial");
+  recoverModelFiles();
+  EXPECT_EQ("new", readFile(MODEL1));
+}
+
+TEST_F(ModelFilesTest, swap)
+{
+  writeFile(MODEL1, "one");
+  writeFile(MODEL2, "two");
+  swapModels(1, 2);
+  EXPECT_EQ("two", readFile(MODEL1));
+  EXPECT_EQ("one", readFile(MODEL2));
+  EXPECT_FALSE(exists(SWAPFILE));
+}
+
+TEST_F(ModelFilesTest, swapInterruptedAfterFirstRename)
+{
+  // model01 parked, model02 not moved yet: the swap is undone
+  writeFile(SWAPFILE, "one");
+  writeFile(MODEL2, "two");
+  recoverModelFiles();
+  EXPECT_EQ("one", readFile(MODEL1));
+  EXPECT_EQ("two", readFile(MODEL2));
+  EXPECT_FALSE(exists(SWAPFILE));
+}
+
+TEST_F(ModelFilesTest, swapInterruptedAfterSecondRename)
+{
+  // model02 already moved to model01: the swap is completed
+  writeFile(SWAPFILE, "one");
+  writeFile(MODEL1, "two");
+  recoverModelFiles();
+  EXPECT_EQ("two", readFile(MODEL1));
+  EXPECT_EQ("one", readFile(MODEL2));
+  EXPECT_FALSE(exists(SWAPFILE));
+}
+
+#endif
@@ -19,6 +19,7 @@
  * GNU General Public License for more details.
  */
 
+#include <chrono>
 #include "gtests.h"
 
 #include "storage/yaml/yaml_tree_walker.h"
@@ -116,3 +117,92 @@ TEST(Sources, getSourceString)
   EXPECT_STREQ(getSourceString(MIXSRC_TrimEle), STR_CHAR_TRIM "Ele");
   EXPECT_STREQ(getSourceString(MIXSRC_TrimThr), STR_CHAR_TRIM "Thr");
 }
+
+TEST(Sources, resolveSource)
+{
+  SourceRef src = resolveSource(MIXSRC_NONE);
+  EXPECT_EQ(SOURCE_KIND_NONE, src.kind);
+
+  src = resolveSource(MIXSRC_MAX);
+  EXPECT_EQ(SOURCE_KIND_MAX, src.kind);
+
+  src = resolveSource(MIXSRC_FIRST_CH + 3);
+  EXPECT_EQ(SOURCE_KIND_CHANNEL, src.kind);
+  EXPECT_EQ(3, src.index);
+
+  src = resolveSource(MIXSRC_FIRST_LOGICAL_SWITCH + 10);
+  EXPECT_EQ(SOURCE_KIND_LOGICAL_SWITCH, src.kind);
+  EXPECT_EQ(10, src.index);
+
+  src = resolveSource(MIXSRC_FIRST_TELEM + 3 * 2 + 1);
+  EXPECT_EQ(SOURCE_KIND_TELEM_MIN, src.kind);
+  EXPECT_EQ(2, src.index);
+
+  src = resolveSource(MIXSRC_LAST_TELEM + 1);
+  EXPECT_EQ(SOURCE_KIND_NONE, src.kind);
+
+  bool valid = true;
+  EXPECT_EQ(0, getSourceValue(src, &valid));
+  EXPECT_FALSE(valid);
+}
+
+// run with --gtest_also_run_disabled_tests
+TEST(Sources, DISABLED_getValueBenchmark)
+{
+  static const mixsrc_t sources[] = {
+    MIXSRC_FIRST_INPUT,       MIXSRC_FIRST_STICK, MIXSRC_MAX,
+    MIXSRC_FIRST_TRIM,        MIXSRC_FIRST_SWITCH,
+    MIXSRC_FIRST_LOGICAL_SWITCH, MIXSRC_FIRST_CH, MIXSRC_FIRST_TIMER,
+    MIXSRC_FIRST_TELEM,
+  };
+  const int rounds = 1000000;
+
+  for (auto source: sources) {
+    SourceRef src = resolveSource(source);
+    volatile getvalue_t sink = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++)
+      sink = sink + getValue(source);
+    auto resolved = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++)
+      sink = sink + getSourceValue(src);
+    auto cached = std::chrono::steady_clock::now() - start;
+
+    printf("source %3d: getValue %.1f ns, cached %.1f ns\n", (int)source,
+           std::chrono::duration<double, std::nano>(resolved).count() / rounds,
+           std::chrono::duration<double, std::nano>(cached).count() / rounds);
+  }
+}
+
+// Logical switches of the comparison family read both v1 and v2 as sources
+TEST(Sources, DISABLED_logicalSwitchBenchmark)
+{
+  static const mixsrc_t sources[] = {
+    MIXSRC_FIRST_INPUT, MIXSRC_FIRST_STICK, MIXSRC_FIRST_TRIM,
+    MIXSRC_FIRST_CH,    MIXSRC_FIRST_TIMER, MIXSRC_FIRST_TELEM,
+  };
+  const int rounds = 1000000;
+
+  for (auto source: sources) {
+    uint32_t cache[2] = {0, 0};
+    volatile getvalue_t sink = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++)
+      sink = sink + (getValue(source) > getValue(MIXSRC_MAX));
+    auto resolved = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++)
+      sink = sink + (getCachedSourceValue(cache[0], source) >
+                     getCachedSourceValue(cache[1], MIXSRC_MAX));
+    auto cached = std::chrono::steady_clock::now() - start;
+
+    printf("source %3d: getValue %.1f ns, cached %.1f ns\n", (int)source,
+           std::chrono::duration<double, std::nano>(resolved).count() / rounds,
+           std::chrono::duration<double, std::nano>(cached).count() / rounds);
+  }
+}
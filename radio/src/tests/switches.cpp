@@ -81,6 +81,22 @@ TEST(getSwitch, nullSW)
   EXPECT_EQ(getSwitch(0), true);
 }
 
+TEST(getSwitch, editedComparisonSource)
+{
+  MODEL_RESET();
+  MIXER_RESET();
+
+  setLogicalSwitch(0, LS_FUNC_GREATER, MIXSRC_MAX, MIXSRC_MIN);
+  evalLogicalSwitches();
+  EXPECT_EQ(getSwitch(SWSRC_SW1), true);
+
+  // the operands are resolved again when they are edited
+  g_model.logicalSw[0].v1 = MIXSRC_MIN;
+  g_model.logicalSw[0].v2 = MIXSRC_MAX;
+  evalLogicalSwitches();
+  EXPECT_EQ(getSwitch(SWSRC_SW1), false);
+}
+
 
 #if defined(PCBTARANIS)
 TEST(getSwitch, inputWithTrim)
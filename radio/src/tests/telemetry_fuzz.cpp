@@ -0,0 +1,358 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "gtests.h"
+
+#include <chrono>
+#include <functional>
+#include <vector>
+
+#include "telemetry/spektrum.h"
+#if defined(CROSSFIRE)
+  #include "telemetry/crossfire.h"
+#endif
+#if defined(GHOST)
+  #include "telemetry/ghost.h"
+#endif
+#if defined(MULTIMODULE)
+  #include "telemetry/flysky_ibus.h"
+  #include "telemetry/hitec.h"
+  #include "telemetry/hott.h"
+  #include "telemetry/mlink.h"
+  #include "telemetry/multi.h"
+#endif
+
+#if defined(__SANITIZE_ADDRESS__)
+  // from <sanitizer/allocator_interface.h>, not shipped with every compiler
+  extern "C" size_t __sanitizer_get_current_allocated_bytes();
+  #define HEAP_IN_USE() __sanitizer_get_current_allocated_bytes()
+#else
+  #define HEAP_IN_USE() 0
+#endif
+
+/*
+  Host side coverage for the telemetry decoders: every decoder is fed
+  mutated copies of a few valid frames, with the frame held in a buffer of
+  exactly its own size so the address sanitizer of the test build catches
+  any read past the end. Length and CRC fields are fixed up after mutating,
+  otherwise nearly everything would be dropped before reaching the payload
+  parsing.
+
+  TELEMETRY_FUZZ_ITERATIONS overrides the number of mutations per decoder.
+  The frames/s benchmark is disabled by default, run it with
+  --gtest_also_run_disabled_tests --gtest_filter=*Benchmark*
+*/
+
+typedef std::vector<uint8_t> Frame;
+
+void setSportPacketCrc(uint8_t * packet);
+
+struct TelemetryDecoder
+{
+  const char * name;
+  uint8_t minLen;
+  uint8_t maxLen;
+  std::vector<Frame> seeds;
+  std::function<void(Frame &)> fixup;
+  std::function<void(Frame &)> decode;
+};
+
+static std::vector<TelemetryDecoder> telemetryDecoders()
+{
+  std::vector<TelemetryDecoder> decoders;
+
+  decoders.push_back({
+    "S.Port", FRSKY_SPORT_PACKET_SIZE, FRSKY_SPORT_PACKET_SIZE,
+    {
+      {0x22, 0x10, 0x10, 0x02, 0x88, 0x13, 0x00, 0x00, 0x00},  // VFAS
+      {0x98, 0x10, 0x00, 0xF1, 0x20, 0x00, 0x00, 0x00, 0x00},  // RSSI
+      {0x83, 0x10, 0x00, 0x08, 0x10, 0x27, 0x00, 0x00, 0x00},  // GPS
+    },
+    [](Frame & f) { setSportPacketCrc(f.data()); },
+    [](Frame & f) { sportProcessTelemetryPacket(0, f.data(), f.size()); },
+  });
+
+  decoders.push_back({
+    "Spektrum", 18, 18,
+    {
+      {0xAA, 0x40, 0x7E, 0x00, 0x00, 0x10, 0x01, 0x20, 0x00, 0x00,
+       0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // RPM
+      {0xAA, 0x40, 0x16, 0x00, 0x12, 0x34, 0x56, 0x78, 0x00, 0x10,
+       0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // GPS location
+    },
+    nullptr,
+    [](Frame & f) { processSpektrumPacket(f.data()); },
+  });
+
+#if defined(CROSSFIRE)
+  auto crossfireFixup = [](Frame & f) {
+    f[0] = RADIO_ADDRESS;
+    f[1] = f.size() - 2;
+    f.back() = crc8(&f[2], f[1] - 1);
+  };
+  decoders.push_back({
+    "CRSF", 4, 64,
+    {
+      {0xEA, 0x0C, 0x14, 0x40, 0x00, 0x64, 0x0A, 0x00, 0x02, 0x01, 0x50, 0x00, 0x00, 0x00},  // link
+      {0xEA, 0x0A, 0x08, 0x00, 0x7B, 0x00, 0x0A, 0x00, 0x01, 0x2C, 0x50, 0x00},  // battery
+      {0xEA, 0x11, 0x02, 0x12, 0x34, 0x56, 0x78, 0x01, 0x23, 0x45, 0x67, 0x00, 0x10,
+       0x03, 0x20, 0x04, 0x00, 0x08, 0x00},  // GPS
+      {0xEA, 0x06, 0x21, 'A', 'C', 'R', 'O', 0x00, 0x00},  // flight mode
+      {0xEA, 0x0D, 0x3A, 0xEA, 0xEE, 0x10, 0x00, 0x00, 0x4E, 0x20, 0x00, 0x00,
+       0x00, 0x10, 0x00},  // timing correction
+    },
+    crossfireFixup,
+    [](Frame & f) { processCrossfireTelemetryFrame(0, f.data(), f.size()); },
+  });
+#endif
+
+#if defined(GHOST)
+  auto ghostFixup = [](Frame & f) {
+    f[0] = GHST_ADDR_RADIO;
+    f[1] = f.size() - 2;
+    f.back() = crc8(&f[2], f[1] - 1);
+  };
+  Frame ghostMenu(sizeof(GhostMenuFrame), ' ');
+  ghostMenu[2] = GHST_DL_MENU_DESC;
+  ghostMenu[5] = 2;
+  decoders.push_back({
+    "Ghost", 4, TELEMETRY_RX_PACKET_SIZE,
+    {
+      {0x80, 0x0C, GHST_DL_LINK_STAT, 0x40, 0x64, 0x0A, 0x00, 0x64, 0x00, 0x96, 0x00, 0x05, 0x02, 0x00},
+      {0x80, 0x0C, GHST_DL_PACK_STAT, 0x7B, 0x00, 0x0A, 0x00, 0x2C, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00},
+      {0x80, 0x0C, GHST_DL_OPENTX_SYNC, 0x00, 0x00, 0x27, 0x10, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00},
+      ghostMenu,
+    },
+    ghostFixup,
+    [](Frame & f) { processGhostTelemetryFrame(0, f.data(), f.size()); },
+  });
+#endif
+
+#if defined(MULTIMODULE)
+  decoders.push_back({
+    "HoTT", 14, 15,
+    {
+      {0x50, 0x64, 0x00, 0x00, 0x00, 0x33, 0x34, 0x50, 0x64, 0x30, 0x00, 0x00, 0x00, 0x00},
+      {0x50, 0x64, 0x09, 0x01, 0x00, 0x10, 0x27, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    },
+    nullptr,
+    [](Frame & f) { processHottPacket(f.data(), f.size()); },
+  });
+
+  decoders.push_back({
+    "M-Link", 9, 9,
+    {
+      {0x1F, 0x64, 0x13, 0x01, 0x22, 0x05, 0x12, 0x40, 0x01},
+      {0x1F, 0x64, 0x13, 0x03, 0x31, 0x00, 0x05, 0x62, 0x00},
+    },
+    nullptr,
+    [](Frame & f) { processMLinkPacket(f.data(), true); },
+  });
+
+  decoders.push_back({
+    "FlySky", 29, 29,
+    {
+      {0x50, 0x00, 0x01, 0x10, 0x01, 0x01, 0x00, 0x40, 0x00, 0xFC, 0x00, 0x05, 0x00, 0x00,
+       0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+      {0x50, 0xFD, 0x00, 0x0E, 0x03, 0x09, 0x12, 0x34, 0x56, 0x78, 0x01, 0x23, 0x45, 0x67,
+       0x10, 0x27, 0x00, 0x00, 0xF0, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    },
+    nullptr,
+    [](Frame & f) {
+      processFlySkyPacket(f.data());
+      processFlySkyPacketAC(f.data());
+    },
+  });
+
+  decoders.push_back({
+    "Hitec", 8, 8,
+    {
+      {0x00, 0x11, 0x00, 0x64, 0x13, 0x88, 0x00, 0x00},
+      {0x00, 0x18, 0x00, 0x10, 0x00, 0x20, 0x00, 0x00},
+    },
+    nullptr,
+    [](Frame & f) { processHitecPacket(f.data()); },
+  });
+#endif
+
+  return decoders;
+}
+
+class TelemetryRandom
+{
+  public:
+    explicit TelemetryRandom(uint32_t seed): state(seed ? seed : 1) {}
+
+    uint32_t next()
+    {
+      // xorshift32, reproducible across platforms
+      state ^= state << 13;
+      state ^= state >> 17;
+      state ^= state << 5;
+      return state;
+    }
+
+    uint32_t below(uint32_t n) { return n ? next() % n : 0; }
+
+  private:
+    uint32_t state;
+};
+
+static void mutateFrame(Frame & f, TelemetryRandom & rnd, uint8_t minLen, uint8_t maxLen)
+{
+  static const uint8_t interesting[] = {0x00, 0x01, 0x7E, 0x7F, 0x80, 0xFE, 0xFF};
+
+  for (uint32_t count = 1 + rnd.below(4); count > 0; count--) {
+    switch (rnd.below(6)) {
+      case 0:
+        f[rnd.below(f.size())] ^= 1 << rnd.below(8);
+        break;
+      case 1:
+        f[rnd.below(f.size())] = rnd.next();
+        break;
+      case 2:
+        f[rnd.below(f.size())] = interesting[rnd.below(DIM(interesting))];
+        break;
+      case 3:
+        if (f.size() < maxLen)
+          f.insert(f.begin() + rnd.below(f.size() + 1), rnd.next());
+        break;
+      case 4:
+        if (f.size() > minLen)
+          f.erase(f.begin() + rnd.below(f.size()));
+        break;
+      case 5:
+        f.resize(minLen + rnd.below(maxLen - minLen + 1), rnd.next());
+        break;
+    }
+  }
+}
+
+static uint32_t fuzzIterations()
+{
+  const char * env = getenv("TELEMETRY_FUZZ_ITERATIONS");
+  return env ? strtoul(env, nullptr, 10) : 2000;
+}
+
+static void telemetryFuzzReset()
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+  telemetryData.telemetryValid = 0x07;
+  allowNewSensors = true;
+}
+
+TEST(TelemetryFuzz, frameDecoders)
+{
+  for (auto & decoder : telemetryDecoders()) {
+    SCOPED_TRACE(decoder.name);
+    telemetryFuzzReset();
+
+    TelemetryRandom rnd(0x5EED);
+    for (uint32_t i = 0; i < fuzzIterations(); i++) {
+      Frame f = decoder.seeds[rnd.below(decoder.seeds.size())];
+      mutateFrame(f, rnd, decoder.minLen, decoder.maxLen);
+      if (decoder.fixup) decoder.fixup(f);
+      // exact size copy, anything past the end is a sanitizer error
+      Frame frame(f);
+      frame.shrink_to_fit();
+      decoder.decode(frame);
+    }
+  }
+}
+
+TEST(TelemetryFuzz, streamDecoders)
+{
+  TelemetryRandom rnd(0xB17E);
+  Frame stream;
+  for (auto & decoder : telemetryDecoders()) {
+    for (auto & seed : decoder.seeds) {
+      Frame f(seed);
+      if (rnd.below(2)) mutateFrame(f, rnd, decoder.minLen, decoder.maxLen);
+      if (decoder.fixup) decoder.fixup(f);
+      stream.push_back(0x7E);
+      stream.insert(stream.end(), f.begin(), f.end());
+    }
+  }
+
+  for (uint32_t i = 0; i < fuzzIterations() / 10; i++) {
+    Frame data(stream);
+    mutateFrame(data, rnd, 1, 255);
+
+    telemetryFuzzReset();
+    uint8_t * buffer = telemetryRxBuffer;
+    uint8_t & len = telemetryRxBufferCount;
+
+    len = 0;
+    for (auto b : data)
+      processFrskySportTelemetryData(0, b, buffer, len);
+
+    len = 0;
+    for (auto b : data)
+      processSpektrumTelemetryData(0, b, buffer, len);
+
+#if defined(MULTIMODULE)
+    len = 0;
+    for (auto b : data)
+      processExternalMLinkSerialData(0, b, buffer, &len);
+
+    len = 0;
+    for (auto b : data)
+      processFlySkyTelemetryData(b, buffer, len);
+
+    getTelemetryRxBufferCount(EXTERNAL_MODULE) = 0;
+    for (auto b : data)
+      processMultiTelemetryData(b, EXTERNAL_MODULE);
+#endif
+  }
+}
+
+TEST(TelemetryFuzz, DISABLED_Benchmark)
+{
+  const uint32_t frames = 200000;
+
+  for (auto & decoder : telemetryDecoders()) {
+    telemetryFuzzReset();
+
+    std::vector<Frame> seeds(decoder.seeds);
+    for (auto & f : seeds)
+      if (decoder.fixup) decoder.fixup(f);
+
+    // warm up: sensors get discovered on the first pass
+    for (auto & f : seeds)
+      decoder.decode(f);
+
+    size_t heap = HEAP_IN_USE();
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < frames; i++)
+      decoder.decode(seeds[i % seeds.size()]);
+    auto end = std::chrono::steady_clock::now();
+    long allocated = (long)HEAP_IN_USE() - (long)heap;
+
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    printf("%-10s %10llu frames/s, heap %+ld bytes\n", decoder.name,
+           us ? (unsigned long long)frames * 1000000 / us : 0ULL, allocated);
+
+    // decoders work on static storage only
+    EXPECT_EQ(allocated, 0) << decoder.name;
+  }
+}
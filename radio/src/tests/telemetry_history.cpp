@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include <vector>
+#include "gtests.h"
+
+#if defined(LUA)
+
+#include "telemetry/telemetry_history.h"
+
+// Samples of a sensor read at a given time
+static std::vector<int32_t> read(TelemetryHistory & history, uint8_t sensor, tmr10ms_t now)
+{
+  int32_t values[TELEMETRY_HISTORY_DEPTH];
+  int count = history.read(sensor, now, TELEMETRY_HISTORY_DEPTH, 0, values);
+  return std::vector<int32_t>(values, values + (count > 0 ? count : 0));
+}
+
+TEST(TelemetryHistory, sampling)
+{
+  TelemetryHistory history;
+
+  EXPECT_EQ(history.size(3), -1);
+  EXPECT_TRUE(history.start(3, 8, 10));
+  EXPECT_EQ(history.size(3), 0);
+
+  history.push(3, 100, 1000);
+  // same period, the newest value is kept
+  history.push(3, 110, 1005);
+  EXPECT_EQ(read(history, 3, 1005), std::vector<int32_t>({110}));
+
+  history.push(3, 120, 1010);
+  // silent for 2 periods, the last value is held
+  history.push(3, 150, 1042);
+  EXPECT_EQ(read(history, 3, 1042), std::vector<int32_t>({110, 120, 120, 120, 150}));
+
+  // other sensors are ignored
+  history.push(2, 500, 1045);
+  EXPECT_EQ(history.size(3), 5);
+
+  // the ring keeps the most recent samples
+  for (int i = 0; i < 10; i++) {
+    history.push(3, i, 1100 + i * 10);
+  }
+  EXPECT_EQ(read(history, 3, 1190), std::vector<int32_t>({2, 3, 4, 5, 6, 7, 8, 9}));
+
+  // the last 4 samples in 2 groups
+  int32_t values[4];
+  EXPECT_EQ(history.read(3, 1190, 4, 2, values), 4);
+  EXPECT_EQ(values[0], 6);
+  EXPECT_EQ(values[1], 7);
+  EXPECT_EQ(values[2], 8);
+  EXPECT_EQ(values[3], 9);
+
+  // fewer samples than points
+  EXPECT_EQ(history.read(3, 1190, 2, 4, values), 2);
+  EXPECT_EQ(values[0], 8);
+  EXPECT_EQ(values[1], 9);
+}
+
+TEST(TelemetryHistory, silentSensor)
+{
+  TelemetryHistory history;
+  EXPECT_TRUE(history.start(0, 8, 10));
+
+  // nothing to hold before the first value
+  EXPECT_TRUE(read(history, 0, 1000).empty());
+
+  history.push(0, 100, 1000);
+  EXPECT_EQ(read(history, 0, 1009).size(), 1u);
+
+  // the last value is held up to the current period
+  EXPECT_EQ(read(history, 0, 1035), std::vector<int32_t>({100, 100, 100, 100}));
+
+  // a value in the current period replaces the held one
+  history.push(0, 200, 1039);
+  EXPECT_EQ(read(history, 0, 1039), std::vector<int32_t>({100, 100, 100, 200}));
+
+  history.push(0, 300, 1040);
+  EXPECT_EQ(read(history, 0, 1040).back(), 300);
+
+  // a long silence is bounded by the depth
+  EXPECT_EQ(read(history, 0, 60000), std::vector<int32_t>(8, 300));
+}
+
+TEST(TelemetryHistory, packing)
+{
+  TelemetryHistory history;
+  EXPECT_TRUE(history.start(0, 4, 1));
+
+  history.push(0, -1000, 0);
+  history.push(0, 30000, 1);
+  EXPECT_EQ(read(history, 0, 1), std::vector<int32_t>({-1000, 30000}));
+
+  // does not fit in 16 bits, the low bits of older samples are lost
+  history.push(0, 100001, 2);
+  EXPECT_EQ(read(history, 0, 2), std::vector<int32_t>({-1000, 30000, 100000}));
+
+  history.push(0, -2000000, 3);
+  int32_t values[2];
+  EXPECT_EQ(history.read(0, 3, 4, 1, values), 4);
+  EXPECT_NEAR(values[0], -2000000, 64);
+  EXPECT_NEAR(values[1], 100000, 64);
+}
+
+TEST(TelemetryHistory, slots)
+{
+  TelemetryHistory history;
+
+  for (int i = 0; i < TELEMETRY_HISTORY_SLOTS; i++) {
+    EXPECT_TRUE(history.start(i, TELEMETRY_HISTORY_DEPTH, 1));
+  }
+  EXPECT_FALSE(history.start(TELEMETRY_HISTORY_SLOTS, 10, 1));
+
+  // reconfiguring an existing slot is fine, its samples are dropped
+  history.push(0, 100, 0);
+  EXPECT_EQ(history.size(0), 1);
+  EXPECT_TRUE(history.start(0, 10, 1));
+  EXPECT_EQ(history.size(0), 0);
+  history.push(0, 100, 1);
+  EXPECT_EQ(history.size(0), 1);
+
+  // the same configuration keeps them
+  EXPECT_TRUE(history.start(0, 10, 1));
+  EXPECT_EQ(history.size(0), 1);
+
+  history.stop(1);
+  EXPECT_TRUE(history.start(TELEMETRY_HISTORY_SLOTS, 10, 1));
+  EXPECT_EQ(history.size(1), -1);
+}
+
+#endif
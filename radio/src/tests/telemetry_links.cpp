@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "gtests.h"
+
+static void linkSetup(uint8_t mode)
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  telemetryReset();
+  g_model.telemetryLinkMode = mode;
+  telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+  allowNewSensors = true;
+}
+
+static void linkReceive(uint8_t module, uint8_t rssi, int32_t vfas)
+{
+  telemetryLinkBegin(module);
+  telemetryData.rssi.set(rssi);
+  setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, VFAS_FIRST_ID, 0, 1, vfas, UNIT_VOLTS, 2);
+  telemetryLinkEnd(module);
+}
+
+static int sensorCount()
+{
+  int count = 0;
+  for (auto & sensor : g_model.telemetrySensors) {
+    if (sensor.isAvailable())
+      count++;
+  }
+  return count;
+}
+
+TEST(TelemetryLinks, shared)
+{
+  linkSetup(TELEM_LINKS_SHARED);
+
+  linkReceive(INTERNAL_MODULE, 50, 1200);
+  linkReceive(EXTERNAL_MODULE, 80, 1100);
+  EXPECT_EQ(sensorCount(), 1);
+  EXPECT_EQ(telemetryItems[0].value, 1100);
+}
+
+TEST(TelemetryLinks, separate)
+{
+  linkSetup(TELEM_LINKS_SEPARATE);
+
+  linkReceive(INTERNAL_MODULE, 50, 1200);
+  linkReceive(EXTERNAL_MODULE, 80, 1100);
+  linkReceive(INTERNAL_MODULE, 50, 1210);
+  EXPECT_EQ(sensorCount(), 2);
+  EXPECT_EQ(g_model.telemetrySensors[0].module, INTERNAL_MODULE);
+  EXPECT_EQ(telemetryItems[0].value, 1210);
+  EXPECT_EQ(g_model.telemetrySensors[1].module, EXTERNAL_MODULE);
+  EXPECT_EQ(telemetryItems[1].value, 1100);
+
+  // the radio RSSI is the one of the first module
+  EXPECT_EQ(TELEMETRY_RSSI(), 50);
+}
+
+TEST(TelemetryLinks, bestRssi)
+{
+  linkSetup(TELEM_LINKS_BEST_RSSI);
+
+  linkReceive(INTERNAL_MODULE, 50, 1200);
+  linkReceive(EXTERNAL_MODULE, 80, 1100);
+  telemetrySelectLink();
+  EXPECT_EQ(telemetryActiveLink(), EXTERNAL_MODULE);
+  EXPECT_EQ(TELEMETRY_RSSI(), 80);
+
+  linkReceive(INTERNAL_MODULE, 50, 1210);
+  linkReceive(EXTERNAL_MODULE, 80, 1110);
+  EXPECT_EQ(sensorCount(), 1);
+  EXPECT_EQ(telemetryItems[0].value, 1110);
+  EXPECT_EQ(TELEMETRY_RSSI(), 80);
+
+  // within the hysteresis, the link does not change
+  linkReceive(INTERNAL_MODULE, 84, 1220);
+  telemetrySelectLink();
+  EXPECT_EQ(telemetryActiveLink(), EXTERNAL_MODULE);
+}
+
+TEST(TelemetryLinks, failover)
+{
+  linkSetup(TELEM_LINKS_FAILOVER);
+
+  linkReceive(INTERNAL_MODULE, 50, 1200);
+  linkReceive(EXTERNAL_MODULE, 80, 1100);
+  telemetrySelectLink();
+  EXPECT_EQ(telemetryActiveLink(), INTERNAL_MODULE);
+  EXPECT_EQ(telemetryItems[0].value, 1200);
+
+  // the internal link times out
+  for (int i = 0; i < TELEMETRY_TIMEOUT10ms; i++) {
+    linkReceive(EXTERNAL_MODULE, 80, 1100);
+    telemetryInterrupt10ms();
+  }
+  telemetrySelectLink();
+  EXPECT_EQ(telemetryActiveLink(), EXTERNAL_MODULE);
+  linkReceive(EXTERNAL_MODULE, 80, 1110);
+  EXPECT_EQ(telemetryItems[0].value, 1110);
+
+  // and takes over again when it comes back
+  linkReceive(INTERNAL_MODULE, 50, 1220);
+  telemetrySelectLink();
+  EXPECT_EQ(telemetryActiveLink(), INTERNAL_MODULE);
+}
+
+TEST(TelemetryLinks, rssiPublishedFromActiveLink)
+{
+  linkSetup(TELEM_LINKS_FAILOVER);
+
+  linkReceive(EXTERNAL_MODULE, 80, 1100);
+  telemetrySelectLink();
+  EXPECT_EQ(telemetryActiveLink(), EXTERNAL_MODULE);
+  EXPECT_EQ(TELEMETRY_RSSI(), 80);
+
+  // readers never see the RSSI of the link being decoded
+  telemetryLinkBegin(INTERNAL_MODULE);
+  telemetryData.rssi.set(20);
+  EXPECT_EQ(TELEMETRY_RSSI(), 80);
+  setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, VFAS_FIRST_ID, 0, 1, 1200, UNIT_VOLTS, 2);
+  telemetryLinkEnd(INTERNAL_MODULE);
+  EXPECT_EQ(TELEMETRY_RSSI(), 80);
+
+  // until that link becomes the active one
+  telemetrySelectLink();
+  EXPECT_EQ(telemetryActiveLink(), INTERNAL_MODULE);
+  EXPECT_EQ(TELEMETRY_RSSI(), 20);
+}
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <string>
+
+#include "gtests.h"
+#include "targets/simu/telemetry_replay.h"
+
+// as written by logTelemetryWriteStart() / logTelemetryWriteByte()
+static const char SPORT_CAPTURE[] =
+  "\r\n2023-05-01,10:00:00.000: 7E 22 10 10 02 88 13 00 00 42"
+  "\r\n2023-05-01,10:00:00.100: 7E 22 10 10 02 92 13 00 00 39"
+  "\r\n2023-05-01,10:00:00.200: 7E 22 10 10 02 7D 5E 13 00"
+  "\r\n2023-05-01,10:00:00.210: 00 4C";
+
+TEST(TelemetryReplay, sportTiming)
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+  telemetryData.telemetryValid = 0x07;
+  allowNewSensors = true;
+
+  TelemetryReplay replay;
+  EXPECT_EQ(replay.parse(SPORT_CAPTURE, sizeof(SPORT_CAPTURE) - 1), 4u);
+
+  replay.start(0, TELEMETRY_REPLAY_SPORT, 1, 1000);
+  replay.wakeup(1000);
+  EXPECT_EQ(replay.getStats().frames, 1u);
+  EXPECT_EQ(telemetryItems[0].value, 5000);
+
+  // second frame has a bad CRC and must not change the value
+  replay.wakeup(1150);
+  EXPECT_EQ(replay.getStats().frames, 2u);
+  EXPECT_EQ(replay.getStats().errors, 1u);
+  EXPECT_EQ(telemetryItems[0].value, 5000);
+
+  // last frame is split over two chunks and byte stuffed
+  replay.wakeup(1200);
+  EXPECT_EQ(replay.getStats().frames, 2u);
+  EXPECT_TRUE(replay.isRunning());
+  replay.wakeup(1210);
+  EXPECT_EQ(replay.getStats().frames, 3u);
+  EXPECT_EQ(telemetryItems[0].value, 4990);
+  EXPECT_FALSE(replay.isRunning());
+  EXPECT_EQ(replay.getStats().bytes, 31u);
+}
+
+TEST(TelemetryReplay, sportAccelerated)
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+  telemetryData.telemetryValid = 0x07;
+  allowNewSensors = true;
+
+  TelemetryReplay replay;
+  replay.parse(SPORT_CAPTURE, sizeof(SPORT_CAPTURE) - 1);
+
+  replay.start(0, TELEMETRY_REPLAY_SPORT, 10, 0);
+  replay.wakeup(10);
+  EXPECT_EQ(replay.getStats().frames, 2u);
+  replay.wakeup(21);
+  EXPECT_EQ(replay.getStats().frames, 3u);
+  EXPECT_EQ(telemetryItems[0].value, 4990);
+}
+
+TEST(TelemetryReplay, clockCorrection)
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+  telemetryData.telemetryValid = 0x07;
+  allowNewSensors = true;
+
+  // the clock was set back by 400ms, this is not a midnight roll-over
+  static const char capture[] =
+    "\r\n2023-05-01,10:00:00.500: 7E 22 10 10 02 88 13 00 00 42"
+    "\r\n2023-05-01,10:00:00.100: 7E 22 10 10 02 7D 5E 13 00 00 4C";
+
+  TelemetryReplay replay;
+  EXPECT_EQ(replay.parse(capture, sizeof(capture) - 1), 2u);
+
+  replay.start(0, TELEMETRY_REPLAY_SPORT, 1, 0);
+  replay.wakeup(0);
+  EXPECT_EQ(replay.getStats().frames, 2u);
+  EXPECT_EQ(telemetryItems[0].value, 4990);
+  EXPECT_FALSE(replay.isRunning());
+}
+
+#if defined(CROSSFIRE)
+TEST(TelemetryReplay, crossfireBadLength)
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+  allowNewSensors = true;
+
+  // a length byte of 0xFE would wrap an 8 bit frame length to 0
+  std::string capture = "\r\n2023-05-01,10:00:00.000: EA FE";
+  for (int i = 0; i < 200; i++) capture += " 55";
+  capture += "\r\n2023-05-01,10:00:00.010: EA 0A 08 00 7B 00 0A 00 01 2C 50 6B";
+
+  TelemetryReplay replay;
+  EXPECT_EQ(replay.parse(capture.c_str(), capture.size()), 2u);
+
+  replay.start(0, TELEMETRY_REPLAY_CROSSFIRE, 1, 0);
+  replay.runAll();
+  EXPECT_EQ(replay.getStats().frames, 1u);
+  EXPECT_EQ(replay.getStats().errors, 1u);
+  EXPECT_EQ(telemetryItems[0].value, 123);
+}
+
+TEST(TelemetryReplay, crossfireBattery)
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+  allowNewSensors = true;
+
+  // leading garbage is skipped until a frame address shows up
+  static const char capture[] =
+    "\r\n2023-05-01,23:59:59.990: 00 FF EA 0A 08 00 7B 00"
+    "\r\n2023-05-02,00:00:00.000: 0A 00 01 2C 50 6B";
+
+  TelemetryReplay replay;
+  EXPECT_EQ(replay.parse(capture, sizeof(capture) - 1), 2u);
+
+  replay.start(0, TELEMETRY_REPLAY_CROSSFIRE, 1, 0);
+  replay.wakeup(5);
+  EXPECT_EQ(replay.getStats().frames, 0u);
+
+  // midnight roll-over keeps the chunks 10ms apart
+  replay.wakeup(10);
+  EXPECT_EQ(replay.getStats().frames, 1u);
+  EXPECT_EQ(replay.getStats().errors, 0u);
+  EXPECT_EQ(telemetryItems[0].value, 123);
+  EXPECT_EQ(telemetryItems[1].value, 10);
+  EXPECT_EQ(telemetryItems[2].value, 300);
+  EXPECT_EQ(telemetryItems[3].value, 80);
+}
+#endif
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   libopenui - https://github.com/opentx/libopenui
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "virtual_table.h"
+
+void VirtualTableField::scroll_cb(lv_event_t* e)
+{
+  lv_obj_t* target = lv_event_get_target(e);
+  if (!target) return;
+
+  auto vt = (VirtualTableField*)lv_obj_get_user_data(target);
+  if (vt) vt->bindVisibleRows();
+}
+
+VirtualTableField::VirtualTableField(Window* parent, const rect_t& rect,
+                                     WindowFlags windowFlags) :
+    TableField(parent, rect, windowFlags)
+{
+  lv_obj_add_event_cb(lvobj, VirtualTableField::scroll_cb, LV_EVENT_SCROLL,
+                      nullptr);
+  lv_obj_add_event_cb(lvobj, VirtualTableField::scroll_cb,
+                      LV_EVENT_SIZE_CHANGED, nullptr);
+}
+
+void VirtualTableField::setItemCount(uint16_t count)
+{
+  // rows removed are freed by lv_table, rows added are bound below
+  boundLast = min(boundLast, min(count, getRowCount()));
+  boundFirst = min(boundFirst, boundLast);
+
+  setRowCount(count);
+  bindVisibleRows();
+}
+
+void VirtualTableField::rebind()
+{
+  for (uint16_t row = boundFirst; row < boundLast; row++) bindRow(row);
+  lv_obj_invalidate(lvobj);
+}
+
+void VirtualTableField::unbindRow(uint16_t row)
+{
+  lv_table_t* table = (lv_table_t*)lvobj;
+  for (uint16_t col = 0; col < table->col_cnt; col++) {
+    char*& cell = table->cell_data[row * table->col_cnt + col];
+    if (cell) {
+      lv_mem_free(cell);
+      cell = nullptr;
+    }
+  }
+}
+
+void VirtualTableField::bindVisibleRows()
+{
+  lv_table_t* table = (lv_table_t*)lvobj;
+
+  // one page above and below the visible one stay bound,
+  // so that short scrolls do not need to bind anything
+  uint16_t first = 0, last = 0;
+  if (table->row_cnt > 0 && table->row_h[0] > 0) {
+    lv_coord_t row_h = table->row_h[0];
+    lv_coord_t scroll_y = max<lv_coord_t>(lv_obj_get_scroll_y(lvobj), 0);
+    uint16_t page = lv_obj_get_height(lvobj) / row_h + 1;
+
+    first = scroll_y / row_h;
+    first = first > page ? first - page : 0;
+    last = min<uint32_t>(first + 3 * page, table->row_cnt);
+  }
+
+  for (uint16_t row = boundFirst; row < boundLast; row++) {
+    if (row < first || row >= last) unbindRow(row);
+  }
+  for (uint16_t row = first; row < last; row++) {
+    if (row < boundFirst || row >= boundLast) bindRow(row);
+  }
+
+  boundFirst = first;
+  boundLast = last;
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   libopenui - https://github.com/opentx/libopenui
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include "table.h"
+
+// Table for long lists: the row count covers every item, but only the
+// rows around the visible area hold a cell string. Rows are bound with
+// bindRow() when they scroll into view and released when they leave it.
+// All rows must have the same height (single line cells).
+class VirtualTableField : public TableField
+{
+ public:
+  VirtualTableField(Window* parent, const rect_t& rect,
+                    WindowFlags windowFlags = OPAQUE);
+
+#if defined(DEBUG_WINDOWS)
+  std::string getName() const override { return "VirtualTable"; }
+#endif
+
+  void setItemCount(uint16_t count);
+
+  // re-binds the rows currently alive, after the items changed
+  void rebind();
+
+ protected:
+  uint16_t boundFirst = 0;
+  uint16_t boundLast = 0;
+
+  // must set the cells of 'row' with lv_table_set_cell_value()
+  virtual void bindRow(uint16_t row) = 0;
+  void unbindRow(uint16_t row);
+  void bindVisibleRows();
+
+  static void scroll_cb(lv_event_t* e);
+};
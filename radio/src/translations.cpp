@@ -656,6 +656,8 @@ const char STR_FILTER[] = TR_FILTER;
 const char STR_TELEMETRYFULL[] = TR_TELEMETRYFULL;
 const char STR_INVERTED_SERIAL[] = TR_INVERTED_SERIAL;
 const char STR_IGNORE_INSTANCE[] = TR_IGNORE_INSTANCE;
+const char STR_TELEMETRY_LINKS[] = TR_TELEMETRY_LINKS;
+ISTR(VTELEMETRY_LINKS);
 const char STR_SHOW_INSTANCE_ID[] = TR_SHOW_INSTANCE_ID;
 const char STR_DISCOVER_SENSORS[] = TR_DISCOVER_SENSORS;
 const char STR_STOP_DISCOVER_SENSORS[] = TR_STOP_DISCOVER_SENSORS;
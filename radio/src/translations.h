@@ -1059,6 +1059,8 @@ extern const char STR_FILTER[];
 extern const char STR_TELEMETRYFULL[];
 extern const char STR_INVERTED_SERIAL[];
 extern const char STR_IGNORE_INSTANCE[];
+extern const char STR_TELEMETRY_LINKS[];
+extern const char* const STR_VTELEMETRY_LINKS[];
 extern const char STR_SHOW_INSTANCE_ID[];
 extern const char STR_DISCOVER_SENSORS[];
 extern const char STR_STOP_DISCOVER_SENSORS[];
@@ -1083,6 +1083,8 @@
 #define TR_TELEMETRYFULL               TR("项目已满!", "回传项目已满!")
 #define TR_INVERTED_SERIAL             INDENT "反向"
 #define TR_IGNORE_INSTANCE             TR(INDENT "忽略ID", INDENT "忽略ID鉴别")
+#define TR_TELEMETRY_LINKS             TR(INDENT "Links", INDENT "Module links")
+#define TR_VTELEMETRY_LINKS            "Shared","Separate","Best RSSI","Failover"
 #define TR_SHOW_INSTANCE_ID            "显示实例ID"
 #define TR_DISCOVER_SENSORS            "扫描新的回传项目"
 #define TR_STOP_DISCOVER_SENSORS       "停止扫描"
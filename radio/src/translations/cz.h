@@ -1105,6 +1105,8 @@
 #define TR_TELEMETRYFULL               "Všechny sloty jsou plné!"
 #define TR_INVERTED_SERIAL             INDENT "Invert"
 #define TR_IGNORE_INSTANCE             TR(INDENT "Chybné ID", INDENT "Ignoruj chyby ID")
+#define TR_TELEMETRY_LINKS             TR(INDENT "Links", INDENT "Module links")
+#define TR_VTELEMETRY_LINKS            "Shared","Separate","Best RSSI","Failover"
 #define TR_SHOW_INSTANCE_ID            "Zobrazit ID instance"
 #define TR_DISCOVER_SENSORS            "Detekovat nové senzory"
 #define TR_STOP_DISCOVER_SENSORS       "Zastavit autodetekci"
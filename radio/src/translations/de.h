@@ -1101,6 +1101,8 @@
 #define TR_TELEMETRYFULL               TR("Telem voll!", "Telemetriezeilen voll!")
 #define TR_INVERTED_SERIAL             INDENT "Invert."
 #define TR_IGNORE_INSTANCE             TR(INDENT "No Inst.", INDENT "Ignor. Instanzen")
+#define TR_TELEMETRY_LINKS             TR(INDENT "Links", INDENT "Module links")
+#define TR_VTELEMETRY_LINKS            "Shared","Separate","Best RSSI","Failover"
 #define TR_SHOW_INSTANCE_ID            "zeige Instanz ID"
 #define TR_DISCOVER_SENSORS            "Start Sensorsuche"
 #define TR_STOP_DISCOVER_SENSORS       "Stop Sensorsuche"
@@ -1094,6 +1094,8 @@
 #define TR_TELEMETRYFULL               TR("All slots full!", "All telemetry slots full!")
 #define TR_INVERTED_SERIAL             INDENT "Invert"
 #define TR_IGNORE_INSTANCE             TR(INDENT "No inst.", INDENT "Ignore instances")
+#define TR_TELEMETRY_LINKS             TR(INDENT "Links", INDENT "Module links")
+#define TR_VTELEMETRY_LINKS            "Shared","Separate","Best RSSI","Failover"
 #define TR_SHOW_INSTANCE_ID            "Show instance ID"
 #define TR_DISCOVER_SENSORS            "Discover new"
 #define TR_STOP_DISCOVER_SENSORS       "Stop"
@@ -1110,6 +1110,8 @@
 #define TR_TELEMETRYFULL               "Plus de capteurs libres!"
 #define TR_INVERTED_SERIAL             INDENT "Inversé"
 #define TR_IGNORE_INSTANCE             TR(INDENT "Ign. inst", INDENT "Ignorer instance")
+#define TR_TELEMETRY_LINKS             TR(INDENT "Links", INDENT "Module links")
+#define TR_VTELEMETRY_LINKS            "Shared","Separate","Best RSSI","Failover"
 #define TR_SHOW_INSTANCE_ID            "Voir instance ID"
 #define TR_DISCOVER_SENSORS            "Découvrir capteurs"
 #define TR_STOP_DISCOVER_SENSORS       "Terminer découverte"
@@ -1102,6 +1102,8 @@
 #define TR_TELEMETRYFULL               TR("All slots full!", "All telemetry slots full!")
 #define TR_INVERTED_SERIAL             INDENT "היפוך"
 #define TR_IGNORE_INSTANCE             TR(INDENT "No inst.", INDENT "Ignore instances")
+#define TR_TELEMETRY_LINKS             TR(INDENT "Links", INDENT "Module links")
+#define TR_VTELEMETRY_LINKS            "Shared","Separate","Best RSSI","Failover"
 #define TR_SHOW_INSTANCE_ID            "הצג מזהה"
 #define TR_DISCOVER_SENSORS            "גלה הכל"
 #define TR_STOP_DISCOVER_SENSORS       "עצור"
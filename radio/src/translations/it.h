@@ -1093,6 +1093,8 @@
 #define TR_TELEMETRYFULL                "Tutti gli slot sono pieni!"
 #define TR_INVERTED_SERIAL              INDENT "Invert."
 #define TR_IGNORE_INSTANCE              TR(INDENT "No inst.", INDENT "Ignora instanza")
+#define TR_TELEMETRY_LINKS              TR(INDENT "Links", INDENT "Module links")
+#define TR_VTELEMETRY_LINKS             "Shared","Separate","Best RSSI","Failover"
 #define TR_SHOW_INSTANCE_ID             "Mostra ID dell'istanza"
 #define TR_DISCOVER_SENSORS             "Cerca nuovi sensori"
 #define TR_STOP_DISCOVER_SENSORS        "Ferma ricerca"
@@ -1089,6 +1089,8 @@
 #define TR_TELEMETRYFULL               TR("All slots full!", "テレメトリー枠はすべて埋まりました!!")
 #define TR_INVERTED_SERIAL             INDENT "リバース"
 #define TR_IGNORE_INSTANCE             TR(INDENT "No inst.", INDENT "ID識別を無視")
+#define TR_TELEMETRY_LINKS             TR(INDENT "Links", INDENT "Module links")
+#define TR_VTELEMETRY_LINKS            "Shared","Separate","Best RSSI","Failover"
 #define TR_SHOW_INSTANCE_ID            "インスタンスIDの表示"
 #define TR_DISCOVER_SENSORS            "新規検索"
 #define TR_STOP_DISCOVER_SENSORS       "停止"
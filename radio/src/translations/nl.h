@@ -1102,6 +1102,8 @@
 //TODO: translation
 #define TR_INVERTED_SERIAL     INDENT "Invert"
 #define TR_IGNORE_INSTANCE     TR(INDENT "Neg. ID ","Negeer ID's")
+#define TR_TELEMETRY_LINKS     TR(INDENT "Links", INDENT "Module links")
+#define TR_VTELEMETRY_LINKS    "Shared","Separate","Best RSSI","Failover"
 #define TR_SHOW_INSTANCE_ID            "Show instance ID"
 #define TR_DISCOVER_SENSORS    "Ontdek nieuwe sensors"
 #define TR_STOP_DISCOVER_SENSORS "Stop ontdekking"
@@ -1092,6 +1092,8 @@
 //TODO: translation
 #define TR_INVERTED_SERIAL     INDENT "Odwróć"
 #define TR_IGNORE_INSTANCE     INDENT "Ignoruj przypadek"
+#define TR_TELEMETRY_LINKS     TR(INDENT "Links", INDENT "Module links")
+#define TR_VTELEMETRY_LINKS    "Shared","Separate","Best RSSI","Failover"
 #define TR_SHOW_INSTANCE_ID    "Pokaż ID instancji"
 #define TR_DISCOVER_SENSORS    "Znajdź nowe czujniki"
 #define TR_STOP_DISCOVER_SENSORS "Szukanie STOP "
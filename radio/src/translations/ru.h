@@ -1096,6 +1096,8 @@
 #define TR_TELEMETRYFULL               TR("Слоты заняты!", "Слоты заняты!")
 #define TR_INVERTED_SERIAL             INDENT "Инвертир"
 #define TR_IGNORE_INSTANCE             TR(INDENT "Нет инстанса", INDENT "Игнор инстансы")
+#define TR_TELEMETRY_LINKS             TR(INDENT "Links", INDENT "Module links")
+#define TR_VTELEMETRY_LINKS            "Shared","Separate","Best RSSI","Failover"
 #define TR_SHOW_INSTANCE_ID            "Показать ID инстанса"
 #define TR_DISCOVER_SENSORS            "Поиск нов датч"
 #define TR_STOP_DISCOVER_SENSORS       "Остановить"
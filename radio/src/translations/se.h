@@ -1124,6 +1124,8 @@
 
 #define TR_INVERTED_SERIAL              INDENT "Inverterad"
 #define TR_IGNORE_INSTANCE              TR(INDENT "Ej inst.", INDENT "Ignorera instansfel")
+#define TR_TELEMETRY_LINKS              TR(INDENT "Links", INDENT "Module links")
+#define TR_VTELEMETRY_LINKS             "Shared","Separate","Best RSSI","Failover"
 #define TR_SHOW_INSTANCE_ID             "Visa instans-ID"
 #define TR_DISCOVER_SENSORS             "Sök nya"
 #define TR_STOP_DISCOVER_SENSORS        "Avbryt sökning"
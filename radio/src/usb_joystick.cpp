@@ -32,6 +32,10 @@ uint8_t _hidReportDescSize = 0;
 uint8_t* _hidReport = nullptr;
 uint8_t _hidReportSize = 0;
 
+// reports are double buffered: _hidReport is built by the mixer
+// while the other one may still be read by the USB interrupt
+static uint8_t* _hidReports = nullptr;
+
 struct _usbJSData {
   uint16_t _usbLastChannelOutput[USBJ_MAX_JOYSTICK_CHANNELS];
   uint8_t _usbChannelTimerActive[USBJ_MAX_JOYSTICK_CHANNELS];
@@ -151,10 +155,11 @@ int setupUSBJoystick()
       return false;
   }
 
-  if (_hidReport == nullptr) {
-    _hidReport = (uint8_t*)malloc(MAX_HID_REPORT);
-    if (_hidReport == nullptr)
+  if (_hidReports == nullptr) {
+    _hidReports = (uint8_t*)malloc(2 * MAX_HID_REPORT);
+    if (_hidReports == nullptr)
       return false;
+    _hidReport = _hidReports;
   }
 
   if (_usbJS == nullptr) {
@@ -174,7 +179,7 @@ int setupUSBJoystick()
   // Init data
   memset(_hidReportDesc, 0, MAX_HID_REPORTDESC);
   _hidReportDescSize = 0;
-  memset(_hidReport, 0, MAX_HID_REPORT);
+  memset(_hidReports, 0, 2 * MAX_HID_REPORT);
   _hidReportSize = 0;
   memset(_buttonState, 0, ((USBJ_BUTTON_SIZE+7) >> 3));
   memset(_usbJS, 0, sizeof(struct _usbJSData));
@@ -609,6 +614,16 @@ struct usbReport_t usbReport()
   return res;
 }
 
+void usbReportSwap()
+{
+  if (_hidReports == nullptr) return;
+
+  if (_hidReport == _hidReports)
+    _hidReport = _hidReports + MAX_HID_REPORT;
+  else
+    _hidReport = _hidReports;
+}
+
 void onUSBJoystickModelChanged()
 {
   if (!usbJoystickActive()) return;
@@ -107,8 +107,13 @@ extern "C" {
 }
 #endif
 
+// Builds the next report from the channel outputs
 struct usbReport_t usbReport();
 
+// The last report was queued for transmission:
+// the next one is built in the other buffer
+void usbReportSwap();
+
 int isUSBAxisCollision(uint8_t chIdx);
 int isUSBSimCollision(uint8_t chIdx);
 int isUSBBtnNumCollision(uint8_t chIdx);